@@ -45,6 +45,7 @@ void Configuration::ReadTopologyParams(const YAML::Node& config) {
   }
 
   const auto& args = config["topology_args"];
+  dim_x = dim_y = 0;
   if (topology == "CUSTOM") {
     for (std::int32_t i = 0; i < args.size(); i++) {
       const auto& branch = args[i];
@@ -75,6 +76,11 @@ void Configuration::ReadTopologyParams(const YAML::Node& config) {
         (std::stringstream() << "Unsupported topology [" << topology << "].")
             .str());
   }
+  // Other topologies are considered as one dimensional
+  if (!dim_x) {
+    dim_x = graph.size();
+    dim_y = 1;
+  }
 
   std::string generator = ReadParam<std::string>(config, "subtopology");
   std::string subnetwork = ReadParam<std::string>(config, "subnetwork");
@@ -114,8 +120,66 @@ void Configuration::ReadRouterParams(const YAML::Node& config) {
   if (buffer_depth < 1) {
     throw std::runtime_error("buffer_depth can not be less than 1.");
   }
+  flow_control = "ABP";
+  if (config["flow_control"].IsDefined()) {
+    flow_control = ReadParam<std::string>(config, "flow_control");
+  }
+  if (flow_control != "ABP" && flow_control != "CREDIT") {
+    throw std::runtime_error("Unsupported flow_control [" + flow_control +
+                             "].");
+  }
+  link_latency = 1;
+  if (config["link_latency"].IsDefined()) {
+    link_latency = ReadParam<std::int32_t>(config, "link_latency");
+  }
+  if (link_latency < 1) {
+    throw std::runtime_error("link_latency can not be less than 1.");
+  }
+  credit_delay = 1;
+  if (config["credit_delay"].IsDefined()) {
+    credit_delay = ReadParam<std::int32_t>(config, "credit_delay");
+  }
+  if (credit_delay < 1) {
+    throw std::runtime_error("credit_delay can not be less than 1.");
+  }
+  router_pipeline = {1, 0, 0, 0};
+  if (config["router_pipeline"].IsDefined()) {
+    router_pipeline =
+        ReadParam<std::vector<std::int32_t>>(config, "router_pipeline");
+  }
+  if (router_pipeline.size() != 4) {
+    throw std::runtime_error("router_pipeline must have 4 stages.");
+  }
+  for (std::int32_t stage : router_pipeline) {
+    if (stage < 0) {
+      throw std::runtime_error(
+          "router_pipeline stage can not be less than 0.");
+    }
+  }
+  lookahead_routing = false;
+  if (config["lookahead_routing"].IsDefined()) {
+    lookahead_routing = ReadParam<bool>(config, "lookahead_routing");
+  }
+  speculative_allocation = false;
+  if (config["speculative_allocation"].IsDefined()) {
+    speculative_allocation = ReadParam<bool>(config, "speculative_allocation");
+  }
   routing_algorithm = ReadParam<std::string>(config, "routing_algorithm");
   selection_strategy = ReadParam<std::string>(config, "selection_strategy");
+
+  channel_dependency_check = "NONE";
+  if (config["channel_dependency_check"].IsDefined()) {
+    channel_dependency_check =
+        ReadParam<std::string>(config, "channel_dependency_check");
+  }
+  if (channel_dependency_check != "NONE" &&
+      channel_dependency_check != "REPORT" &&
+      channel_dependency_check != "ABORT") {
+    throw std::runtime_error((std::stringstream()
+                              << "Unsupported channel_dependency_check ["
+                              << channel_dependency_check << "].")
+                                 .str());
+  }
 }
 void Configuration::ReadRoutingTableParams(const YAML::Node& config) {
   try {
@@ -213,6 +277,38 @@ void Configuration::ReadSimulationParams(const YAML::Node& config) {
   report_sub_routing_table =
       ReadParam<bool>(config, "report_sub_routing_table");
   report_cycle_result = ReadParam<bool>(config, "report_cycle_result");
+  cycle_result_period = 100;
+  if (config["cycle_result_period"].IsDefined()) {
+    cycle_result_period =
+        ReadParam<std::int32_t>(config, "cycle_result_period");
+  }
+  if (cycle_result_period < 1) {
+    throw std::runtime_error("cycle_result_period can not be less than 1.");
+  }
+  cycle_result_filename = "cycle_result.csv";
+  if (config["cycle_result_filename"].IsDefined()) {
+    cycle_result_filename =
+        ReadParam<std::string>(config, "cycle_result_filename");
+  }
+  cycle_result_format = "CSV";
+  if (config["cycle_result_format"].IsDefined()) {
+    cycle_result_format = ReadParam<std::string>(config, "cycle_result_format");
+  }
+  if (cycle_result_format != "CSV" && cycle_result_format != "BINARY") {
+    throw std::runtime_error("Unsupported cycle_result_format [" +
+                             cycle_result_format + "].");
+  }
+  if (config["result_filename"].IsDefined()) {
+    result_filename = ReadParam<std::string>(config, "result_filename");
+  }
+  result_format = "JSONL";
+  if (config["result_format"].IsDefined()) {
+    result_format = ReadParam<std::string>(config, "result_format");
+  }
+  if (result_format != "JSONL" && result_format != "CSV") {
+    throw std::runtime_error("Unsupported result_format [" + result_format +
+                             "].");
+  }
 
   flit_trace_start = -1;
   flit_trace_end = -1;
@@ -226,7 +322,44 @@ void Configuration::ReadSimulationParams(const YAML::Node& config) {
   } else {
     report_flit_trace = node.as<bool>();
   }
+  if (config["flit_trace_filename"].IsDefined()) {
+    flit_trace_filename = ReadParam<std::string>(config, "flit_trace_filename");
+  }
+  flit_trace_sampling = 1;
+  if (config["flit_trace_sampling"].IsDefined()) {
+    flit_trace_sampling =
+        ReadParam<std::int32_t>(config, "flit_trace_sampling");
+  }
+  if (flit_trace_sampling < 1) {
+    throw std::runtime_error("flit_trace_sampling can not be less than 1.");
+  }
+  if (config["flit_trace_sources"].IsDefined()) {
+    flit_trace_sources =
+        config["flit_trace_sources"].as<std::vector<std::int32_t>>();
+  }
+  if (config["flit_trace_destinations"].IsDefined()) {
+    flit_trace_destinations =
+        config["flit_trace_destinations"].as<std::vector<std::int32_t>>();
+  }
   report_distribution = ReadParam<bool>(config, "report_distribution");
+  report_latency_breakdown = false;
+  if (config["report_latency_breakdown"].IsDefined()) {
+    report_latency_breakdown =
+        ReadParam<bool>(config, "report_latency_breakdown");
+  }
+  report_links = false;
+  if (config["report_links"].IsDefined()) {
+    report_links = ReadParam<bool>(config, "report_links");
+  }
+  if (config["flow_matrix_filename"].IsDefined()) {
+    flow_matrix_filename =
+        ReadParam<std::string>(config, "flow_matrix_filename");
+  }
+  report_delay_components = false;
+  if (config["report_delay_components"].IsDefined()) {
+    report_delay_components =
+        ReadParam<bool>(config, "report_delay_components");
+  }
 
   clock_period_ps = ReadParam<std::int32_t>(config, "clock_period_ps");
   if (clock_period_ps < 1) {
@@ -250,6 +383,15 @@ void Configuration::ReadSimulationParams(const YAML::Node& config) {
   if (stats_warm_up_time < 0) {
     throw std::runtime_error("stats_warm_up_time can not be less than 0.");
   }
+  deadlock_detection_cycles = 0;
+  if (config["deadlock_detection_cycles"].IsDefined()) {
+    deadlock_detection_cycles =
+        ReadParam<std::int32_t>(config, "deadlock_detection_cycles");
+  }
+  if (deadlock_detection_cycles < 0) {
+    throw std::runtime_error(
+        "deadlock_detection_cycles can not be less than 0.");
+  }
 
   min_packet_size = ReadParam<std::int32_t>(config, "min_packet_size");
   if (min_packet_size < 1) {
@@ -273,22 +415,94 @@ void Configuration::ReadSimulationParams(const YAML::Node& config) {
     throw std::runtime_error(
         "max_packet_size can not be less than min_packet_size.");
   }
+
+  source_queue_capacity = 64;
+  if (config["source_queue_capacity"].IsDefined()) {
+    source_queue_capacity =
+        ReadParam<std::int32_t>(config, "source_queue_capacity");
+  }
+  if (source_queue_capacity < 1) {
+    throw std::runtime_error("source_queue_capacity can not be less than 1.");
+  }
+  source_queue_policy = "BACKPRESSURE";
+  if (config["source_queue_policy"].IsDefined()) {
+    source_queue_policy =
+        ReadParam<std::string>(config, "source_queue_policy");
+  }
+  if (source_queue_policy != "BACKPRESSURE" && source_queue_policy != "DROP") {
+    throw std::runtime_error("Invalid source_queue_policy [" +
+                             source_queue_policy + "].");
+  }
+
+  closed_loop = false;
+  if (config["closed_loop"].IsDefined()) {
+    closed_loop = ReadParam<bool>(config, "closed_loop");
+  }
+  max_outstanding_requests = 1;
+  if (config["max_outstanding_requests"].IsDefined()) {
+    max_outstanding_requests =
+        ReadParam<std::int32_t>(config, "max_outstanding_requests");
+  }
+  if (max_outstanding_requests < 1) {
+    throw std::runtime_error(
+        "max_outstanding_requests can not be less than 1.");
+  }
+  reply_service_time = 0;
+  if (config["reply_service_time"].IsDefined()) {
+    reply_service_time = ReadParam<std::int32_t>(config, "reply_service_time");
+  }
+  if (reply_service_time < 0) {
+    throw std::runtime_error("reply_service_time can not be less than 0.");
+  }
+  reply_packet_size = 0;
+  if (config["reply_packet_size"].IsDefined()) {
+    reply_packet_size = ReadParam<std::int32_t>(config, "reply_packet_size");
+  }
+  if (reply_packet_size < 0) {
+    throw std::runtime_error("reply_packet_size can not be less than 0.");
+  }
 }
 void Configuration::ReadTrafficDistributionParams(const YAML::Node& config) {
   traffic_distribution = ReadParam<std::string>(config, "traffic_distribution");
   if (traffic_distribution == "TRAFFIC_TABLE_BASED")
     traffic_table_filename =
         ReadParam<std::string>(config, "traffic_table_filename");
+  else if (traffic_distribution == "TRAFFIC_TRACE")
+    traffic_trace_filename =
+        ReadParam<std::string>(config, "traffic_trace_filename");
+  else if (traffic_distribution == "TRAFFIC_TASK_GRAPH")
+    traffic_task_graph_filename =
+        ReadParam<std::string>(config, "traffic_task_graph_filename");
+  else if (traffic_distribution == "TRAFFIC_MULTICAST")
+    traffic_multicast_size =
+        ReadParam<std::int32_t>(config, "traffic_multicast_size");
   else if (traffic_distribution == "TRAFFIC_HOTSPOT") {
     const auto& traffic_hotspots = config["traffic_hotspots"];
     for (std::int32_t i = 0; i < traffic_hotspots.size(); i++) {
       const auto& hotspot = traffic_hotspots[i];
       hotspots.push_back(
           std::make_pair(hotspot[0].as<std::int32_t>(),
-                         std::make_pair(hotspot[1].as<std::int32_t>(),
-                                        hotspot[2].as<std::int32_t>())));
+                         std::make_pair(hotspot[1].as<double>(),
+                                        hotspot[2].as<double>())));
     }
   }
+
+  traffic_burst_length = 0;
+  if (config["traffic_burst_length"].IsDefined()) {
+    traffic_burst_length = ReadParam<double>(config, "traffic_burst_length");
+  }
+  if (traffic_burst_length != 0 && traffic_burst_length < 1) {
+    throw std::runtime_error(
+        "traffic_burst_length must be 0 or not less than 1.");
+  }
+  traffic_burst_duty_cycle = 1;
+  if (config["traffic_burst_duty_cycle"].IsDefined()) {
+    traffic_burst_duty_cycle =
+        ReadParam<double>(config, "traffic_burst_duty_cycle");
+  }
+  if (traffic_burst_duty_cycle <= 0 || traffic_burst_duty_cycle > 1) {
+    throw std::runtime_error("traffic_burst_duty_cycle must be in (0, 1].");
+  }
 }
 
 void Configuration::ReportData() {
@@ -412,6 +626,11 @@ Configuration::Configuration(std::int32_t arg_num, char* arg_vet[]) {
   }
 
   ParseArgs(config, arg_num, arg_vet);
+  for (const auto& param : config) {
+    YAML::Emitter value;
+    value << YAML::Flow << param.second;
+    parameters.emplace_back(param.first.as<std::string>(), value.c_str());
+  }
 
   ReadTopologyParams(config);
   ReadRouterParams(config);
@@ -465,8 +684,7 @@ const Graph& Configuration::TopologySubGraph() const { return subgraph; }
 const Graph& Configuration::NetworkGraph() const { return network_graph; }
 const RoutingTable& Configuration::GRTable() const { return table; }
 const RoutingTable& Configuration::SubGRTable() const { return subtable; }
-const std::vector<
-    std::pair<std::int32_t, std::pair<std::int32_t, std::int32_t>>>&
+const std::vector<std::pair<std::int32_t, std::pair<double, double>>>&
 Configuration::Hotspots() const {
   return hotspots;
 }
@@ -475,6 +693,16 @@ const std::vector<std::int32_t> Configuration::UpdateSequence() const {
   return update_sequence;
 }
 std::int32_t Configuration::BufferDepth() const { return buffer_depth; }
+const std::string& Configuration::FlowControl() const { return flow_control; }
+std::int32_t Configuration::LinkLatency() const { return link_latency; }
+std::int32_t Configuration::CreditDelay() const { return credit_delay; }
+const std::vector<std::int32_t>& Configuration::RouterPipeline() const {
+  return router_pipeline;
+}
+bool Configuration::LookaheadRouting() const { return lookahead_routing; }
+bool Configuration::SpeculativeAllocation() const {
+  return speculative_allocation;
+}
 std::int32_t Configuration::MinPacketSize() const { return min_packet_size; }
 std::int32_t Configuration::MaxPacketSize() const { return max_packet_size; }
 const std::string& Configuration::RoutingAlgorithm() const {
@@ -483,6 +711,9 @@ const std::string& Configuration::RoutingAlgorithm() const {
 const std::string& Configuration::SelectionStrategy() const {
   return selection_strategy;
 }
+const std::string& Configuration::ChannelDependencyCheck() const {
+  return channel_dependency_check;
+}
 double Configuration::PacketInjectionRate() const {
   if (!flit_injection_rate)
     return packet_injection_rate / (scale_with_nodes ? graph.size() : 1.0);
@@ -497,6 +728,37 @@ const std::string& Configuration::TrafficDistribution() const {
 const std::string& Configuration::TrafficTableFilename() const {
   return traffic_table_filename;
 }
+const std::string& Configuration::TrafficTraceFilename() const {
+  return traffic_trace_filename;
+}
+const std::string& Configuration::TrafficTaskGraphFilename() const {
+  return traffic_task_graph_filename;
+}
+std::int32_t Configuration::TrafficMulticastSize() const {
+  return traffic_multicast_size;
+}
+double Configuration::TrafficBurstLength() const {
+  return traffic_burst_length;
+}
+double Configuration::TrafficBurstDutyCycle() const {
+  return traffic_burst_duty_cycle;
+}
+bool Configuration::ClosedLoop() const { return closed_loop; }
+std::int32_t Configuration::SourceQueueCapacity() const {
+  return source_queue_capacity;
+}
+const std::string& Configuration::SourceQueuePolicy() const {
+  return source_queue_policy;
+}
+std::int32_t Configuration::MaxOutstandingRequests() const {
+  return max_outstanding_requests;
+}
+std::int32_t Configuration::ReplyServiceTime() const {
+  return reply_service_time;
+}
+std::int32_t Configuration::ReplyPacketSize() const {
+  return reply_packet_size;
+}
 std::int32_t Configuration::ClockPeriodPS() const { return clock_period_ps; }
 std::int32_t Configuration::SimulationTime() const { return simulation_time; }
 std::int32_t Configuration::ProductionTime() const { return production_time; }
@@ -504,6 +766,9 @@ std::int32_t Configuration::ResetTime() const { return reset_time; }
 std::int32_t Configuration::StatsWarmUpTime() const {
   return stats_warm_up_time;
 }
+std::int32_t Configuration::DeadlockDetectionCycles() const {
+  return deadlock_detection_cycles;
+}
 std::int32_t Configuration::RndGeneratorSeed() const {
   return rnd_generator_seed;
 }
@@ -511,10 +776,50 @@ bool Configuration::ReportProgress() const { return report_progress; }
 bool Configuration::JsonResult() const { return json_result; }
 bool Configuration::ReportBuffers() const { return report_buffers; }
 bool Configuration::ReportCycleResult() const { return report_cycle_result; }
+std::int32_t Configuration::CycleResultPeriod() const {
+  return cycle_result_period;
+}
+const std::string& Configuration::CycleResultFilename() const {
+  return cycle_result_filename;
+}
+const std::string& Configuration::CycleResultFormat() const {
+  return cycle_result_format;
+}
+const std::string& Configuration::ResultFilename() const {
+  return result_filename;
+}
+const std::string& Configuration::ResultFormat() const { return result_format; }
 bool Configuration::ReportFlitTrace() const { return report_flit_trace; }
 bool Configuration::ReportDistribution() const { return report_distribution; }
+bool Configuration::ReportLatencyBreakdown() const {
+  return report_latency_breakdown;
+}
+bool Configuration::ReportLinks() const { return report_links; }
+const std::string& Configuration::FlowMatrixFilename() const {
+  return flow_matrix_filename;
+}
+bool Configuration::ReportDelayComponents() const {
+  return report_delay_components;
+}
 double Configuration::FlitTraceStart() const { return flit_trace_start; }
 double Configuration::FlitTraceEnd() const { return flit_trace_end; }
+const std::string& Configuration::FlitTraceFilename() const {
+  return flit_trace_filename;
+}
+std::int32_t Configuration::FlitTraceSampling() const {
+  return flit_trace_sampling;
+}
+const std::vector<std::int32_t>& Configuration::FlitTraceSources() const {
+  return flit_trace_sources;
+}
+const std::vector<std::int32_t>& Configuration::FlitTraceDestinations()
+    const {
+  return flit_trace_destinations;
+}
+const std::vector<std::pair<std::string, std::string>>&
+Configuration::Parameters() const {
+  return parameters;
+}
 
 std::int32_t Configuration::DimX() const { return dim_x; }
 std::int32_t Configuration::DimY() const { return dim_y; }
@@ -18,21 +18,40 @@ class Configuration {
 
   std::vector<std::int32_t> update_sequence;
   std::int32_t buffer_depth;
+  std::string flow_control;
+  std::int32_t link_latency;
+  std::int32_t credit_delay;
+  std::vector<std::int32_t> router_pipeline;
+  bool lookahead_routing;
+  bool speculative_allocation;
   std::int32_t min_packet_size;
   std::int32_t max_packet_size;
   std::string routing_algorithm;
   std::string selection_strategy;
+  std::string channel_dependency_check;
   bool flit_injection_rate;
   bool scale_with_nodes;
   double packet_injection_rate;
   double locality;
   std::string traffic_distribution;
   std::string traffic_table_filename;
+  std::string traffic_trace_filename;
+  std::string traffic_task_graph_filename;
+  std::int32_t traffic_multicast_size;
+  double traffic_burst_length;
+  double traffic_burst_duty_cycle;
+  bool closed_loop;
+  std::int32_t source_queue_capacity;
+  std::string source_queue_policy;
+  std::int32_t max_outstanding_requests;
+  std::int32_t reply_service_time;
+  std::int32_t reply_packet_size;
   std::int32_t clock_period_ps;
   std::int32_t simulation_time;
   std::int32_t production_time;
   std::int32_t reset_time;
   std::int32_t stats_warm_up_time;
+  std::int32_t deadlock_detection_cycles;
   std::int32_t rnd_generator_seed;
   std::int32_t dim_x, dim_y;
   std::int32_t channels_count;
@@ -49,13 +68,27 @@ class Configuration {
   bool report_topology_sub_graph;
   bool report_topology_sub_graph_adjacency_matrix;
   bool report_cycle_result;
+  std::int32_t cycle_result_period;
+  std::string cycle_result_filename;
+  std::string cycle_result_format;
+  std::string result_filename;
+  std::string result_format;
   bool report_flit_trace;
   bool report_distribution;
+  bool report_latency_breakdown;
+  bool report_links;
+  std::string flow_matrix_filename;
+  bool report_delay_components;
   double flit_trace_start;
   double flit_trace_end;
+  std::string flit_trace_filename;
+  std::int32_t flit_trace_sampling;
+  std::vector<std::int32_t> flit_trace_sources;
+  std::vector<std::int32_t> flit_trace_destinations;
+  // Parameters after command line overrides as YAML text, in file order
+  std::vector<std::pair<std::string, std::string>> parameters;
 
-  std::vector<std::pair<std::int32_t, std::pair<std::int32_t, std::int32_t>>>
-      hotspots;
+  std::vector<std::pair<std::int32_t, std::pair<double, double>>> hotspots;
 
   Graph graph;
   Graph subgraph;
@@ -84,35 +117,67 @@ class Configuration {
   const Graph& NetworkGraph() const;
   const RoutingTable& GRTable() const;
   const RoutingTable& SubGRTable() const;
-  const std::vector<
-      std::pair<std::int32_t, std::pair<std::int32_t, std::int32_t>>>&
+  const std::vector<std::pair<std::int32_t, std::pair<double, double>>>&
   Hotspots() const;
 
   const std::vector<std::int32_t> UpdateSequence() const;
   std::int32_t BufferDepth() const;
+  const std::string& FlowControl() const;
+  std::int32_t LinkLatency() const;
+  std::int32_t CreditDelay() const;
+  const std::vector<std::int32_t>& RouterPipeline() const;
+  bool LookaheadRouting() const;
+  bool SpeculativeAllocation() const;
   std::int32_t MinPacketSize() const;
   std::int32_t MaxPacketSize() const;
 
   const std::string& RoutingAlgorithm() const;
   const std::string& SelectionStrategy() const;
+  const std::string& ChannelDependencyCheck() const;
   double PacketInjectionRate() const;
   double Locality() const;
   const std::string& TrafficDistribution() const;
   const std::string& TrafficTableFilename() const;
+  const std::string& TrafficTraceFilename() const;
+  const std::string& TrafficTaskGraphFilename() const;
+  std::int32_t TrafficMulticastSize() const;
+  double TrafficBurstLength() const;
+  double TrafficBurstDutyCycle() const;
+  bool ClosedLoop() const;
+  std::int32_t SourceQueueCapacity() const;
+  const std::string& SourceQueuePolicy() const;
+  std::int32_t MaxOutstandingRequests() const;
+  std::int32_t ReplyServiceTime() const;
+  std::int32_t ReplyPacketSize() const;
   std::int32_t ClockPeriodPS() const;
   std::int32_t SimulationTime() const;
   std::int32_t ProductionTime() const;
   std::int32_t ResetTime() const;
   std::int32_t StatsWarmUpTime() const;
+  std::int32_t DeadlockDetectionCycles() const;
   std::int32_t RndGeneratorSeed() const;
   bool ReportProgress() const;
   bool JsonResult() const;
   bool ReportBuffers() const;
   bool ReportCycleResult() const;
+  std::int32_t CycleResultPeriod() const;
+  const std::string& CycleResultFilename() const;
+  const std::string& CycleResultFormat() const;
+  const std::string& ResultFilename() const;
+  const std::string& ResultFormat() const;
   bool ReportFlitTrace() const;
   bool ReportDistribution() const;
+  bool ReportLatencyBreakdown() const;
+  bool ReportLinks() const;
+  const std::string& FlowMatrixFilename() const;
+  bool ReportDelayComponents() const;
   double FlitTraceStart() const;
   double FlitTraceEnd() const;
+  const std::string& FlitTraceFilename() const;
+  std::int32_t FlitTraceSampling() const;
+  const std::vector<std::int32_t>& FlitTraceSources() const;
+  const std::vector<std::int32_t>& FlitTraceDestinations() const;
+  const std::vector<std::pair<std::string, std::string>>& Parameters() const;
 
   std::int32_t DimX() const;
   std::int32_t DimY() const;
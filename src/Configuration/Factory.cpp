@@ -1,11 +1,17 @@
 #include "Factory.hpp"
 
+#include <algorithm>
 #include <memory>
 
 #include "Configuration/Configuration.hpp"
+#include "Configuration/TrafficManagers/BurstyTrafficManager.hpp"
 #include "Configuration/TrafficManagers/HotspotTrafficManager.hpp"
+#include "Configuration/TrafficManagers/MulticastTrafficManager.hpp"
+#include "Configuration/TrafficManagers/PermutationTrafficManager.hpp"
 #include "Configuration/TrafficManagers/RandomTrafficManager.hpp"
 #include "Configuration/TrafficManagers/TableTrafficManager.hpp"
+#include "Configuration/TrafficManagers/TaskGraphTrafficManager.hpp"
+#include "Configuration/TrafficManagers/TraceTrafficManager.hpp"
 #include "Routing/RoutingBypass.hpp"
 #include "Routing/RoutingFitSubnetwork.hpp"
 #include "Routing/RoutingFitVirtualSubnetwork.hpp"
@@ -102,7 +108,7 @@ std::unique_ptr<SelectionStrategy> Factory::MakeStrategy() const {
                            config.SelectionStrategy() + "].");
 }
 
-std::unique_ptr<TrafficManager> Factory::MakeTraffic() const {
+std::unique_ptr<TrafficManager> Factory::MakeDistribution() const {
   if (config.TrafficDistribution() == "TRAFFIC_RANDOM")
     return std::make_unique<RandomTrafficManager>(config.RndGeneratorSeed(),
                                                   config.TopologyGraph().size(),
@@ -116,7 +122,40 @@ std::unique_ptr<TrafficManager> Factory::MakeTraffic() const {
         config.RndGeneratorSeed(), config.TopologyGraph().size(),
         config.TrafficTableFilename(), config.PacketInjectionRate(),
         config.SimulationTime());
+  const auto& patterns = PermutationTrafficManager::Patterns;
+  if (std::find(patterns.begin(), patterns.end(),
+                config.TrafficDistribution()) != patterns.end())
+    return std::make_unique<PermutationTrafficManager>(
+        config.RndGeneratorSeed(), config.DimX(), config.DimY(),
+        config.PacketInjectionRate(), config.TrafficDistribution());
+  if (config.TrafficDistribution() == "TRAFFIC_BROADCAST")
+    return std::make_unique<MulticastTrafficManager>(
+        config.RndGeneratorSeed(), config.TopologyGraph().size(),
+        config.PacketInjectionRate(), config.TopologyGraph().size() - 1,
+        config.ResetTime());
+  if (config.TrafficDistribution() == "TRAFFIC_MULTICAST")
+    return std::make_unique<MulticastTrafficManager>(
+        config.RndGeneratorSeed(), config.TopologyGraph().size(),
+        config.PacketInjectionRate(), config.TrafficMulticastSize(),
+        config.ResetTime());
+  if (config.TrafficDistribution() == "TRAFFIC_TRACE")
+    return std::make_unique<TraceTrafficManager>(
+        config.TopologyGraph().size(), config.TrafficTraceFilename(),
+        config.ResetTime());
+  if (config.TrafficDistribution() == "TRAFFIC_TASK_GRAPH")
+    return std::make_unique<TaskGraphTrafficManager>(
+        config.TopologyGraph().size(), config.TrafficTaskGraphFilename(),
+        config.ResetTime());
   throw std::runtime_error(
       "Configuration error: Invalid traffic distribution [" +
       config.TrafficDistribution() + "].");
 }
+std::unique_ptr<TrafficManager> Factory::MakeTraffic() const {
+  auto traffic = MakeDistribution();
+  if (config.TrafficBurstLength() > 0)
+    return std::make_unique<BurstyTrafficManager>(
+        config.RndGeneratorSeed(), config.TopologyGraph().size(),
+        std::move(traffic), config.TrafficBurstLength(),
+        config.TrafficBurstDutyCycle());
+  return traffic;
+}
@@ -8,6 +8,8 @@ class Factory {
  private:
   const Configuration& config;
 
+  std::unique_ptr<TrafficManager> MakeDistribution() const;
+
  public:
   Factory(const Configuration& cfg) : config(cfg) {}
 
@@ -1,5 +1,6 @@
 #include "Graph.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -116,6 +117,16 @@ Graph Graph::operator+(const Graph& g) {
   return result;
 }
 
+std::int32_t Graph::back_link(std::int32_t node, std::int32_t link) const {
+  std::int32_t neighbour = at(node)[link];
+  if (neighbour < 0 || neighbour >= size()) return EmptyLink;
+
+  auto links = at(node).links_to(neighbour);
+  auto back_links = at(neighbour).links_to(node);
+  std::size_t i = std::find(links.begin(), links.end(), link) - links.begin();
+  return i < back_links.size() ? back_links[i] : EmptyLink;
+}
+
 std::vector<std::vector<Graph::PathNode>> Graph::get_paths(
     std::int32_t from, std::int32_t to) const {
   constexpr std::int32_t inf = std::numeric_limits<std::int32_t>::max();
@@ -55,6 +55,10 @@ class Graph : public std::vector<GraphNode> {
 
   Graph operator+(const Graph& g);
 
+  // Port of the neighbour node which is connected to the given port,
+  // i-th link from A to B is bound to i-th link from B to A
+  std::int32_t back_link(std::int32_t node, std::int32_t link) const;
+
   std::vector<std::vector<PathNode>> get_paths(std::int32_t from,
                                                std::int32_t to) const;
   std::vector<std::vector<std::int32_t>> get_simple_paths(
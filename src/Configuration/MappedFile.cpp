@@ -0,0 +1,51 @@
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+MappedFile::MappedFile(const std::string& path) {
+  int descriptor = open(path.c_str(), O_RDONLY);
+  if (descriptor < 0)
+    throw std::runtime_error("MappedFile error: File [" + path +
+                             "] can not be opened.");
+
+  struct stat info;
+  if (fstat(descriptor, &info) < 0) {
+    close(descriptor);
+    throw std::runtime_error("MappedFile error: File [" + path +
+                             "] can not be accessed.");
+  }
+
+  size = info.st_size;
+  if (size > 0) {
+    void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (address == MAP_FAILED) {
+      close(descriptor);
+      throw std::runtime_error("MappedFile error: File [" + path +
+                               "] can not be mapped.");
+    }
+    data = static_cast<const char*>(address);
+  }
+
+  // Mapping stays valid after descriptor is closed
+  close(descriptor);
+}
+MappedFile::~MappedFile() {
+  if (data) munmap(const_cast<char*>(data), size);
+  data = nullptr;
+  size = 0;
+}
+
+void MappedFile::AdviseSequential() const {
+  if (data) madvise(const_cast<char*>(data), size, MADV_SEQUENTIAL);
+}
+void MappedFile::Release(std::size_t offset) const {
+  std::size_t page = sysconf(_SC_PAGESIZE);
+  std::size_t length = std::min(offset, size) / page * page;
+  if (data && length) madvise(const_cast<char*>(data), length, MADV_DONTNEED);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of the whole file
+class MappedFile {
+ private:
+  const char* data = nullptr;
+  std::size_t size = 0;
+
+ public:
+  MappedFile(const std::string& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* Data() const { return data; }
+  std::size_t Size() const { return size; }
+
+  // Hints kernel that file is read sequentially
+  void AdviseSequential() const;
+  // Drops resident pages before the given offset, they are read again from
+  // the file on access
+  void Release(std::size_t offset) const;
+};
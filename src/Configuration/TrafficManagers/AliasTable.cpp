@@ -0,0 +1,48 @@
+#include "AliasTable.hpp"
+
+#include <stdexcept>
+
+AliasTable::AliasTable(const std::vector<std::int32_t>& vals,
+                       const std::vector<double>& weights) {
+  if (vals.size() != weights.size())
+    throw std::runtime_error(
+        "AliasTable error: Values and weights sizes mismatch.");
+
+  double total = 0;
+  for (std::size_t i = 0; i < vals.size(); i++) {
+    if (weights[i] < 0)
+      throw std::runtime_error("AliasTable error: Negative weight.");
+    if (weights[i] > 0) {
+      values.push_back(vals[i]);
+      probabilities.push_back(weights[i]);
+      total += weights[i];
+    }
+  }
+  aliases.resize(values.size());
+
+  // Vose's method: split scaled weights into small and large ones and pair
+  // each small slot with some large value
+  std::vector<std::size_t> small, large;
+  for (std::size_t i = 0; i < values.size(); i++) {
+    probabilities[i] *= values.size() / total;
+    aliases[i] = i;
+    if (probabilities[i] < 1)
+      small.push_back(i);
+    else
+      large.push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    std::size_t s = small.back();
+    std::size_t l = large.back();
+    small.pop_back();
+
+    aliases[s] = l;
+    probabilities[l] -= 1 - probabilities[s];
+    if (probabilities[l] < 1) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  for (std::size_t i : large) probabilities[i] = 1;
+  for (std::size_t i : small) probabilities[i] = 1;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Walker alias table for O(1) sampling of values with given weights
+class AliasTable {
+ private:
+  std::vector<std::int32_t> values;
+  std::vector<std::int32_t> aliases;
+  std::vector<double> probabilities;
+
+ public:
+  AliasTable() {}
+  AliasTable(const std::vector<std::int32_t>& values,
+             const std::vector<double>& weights);
+
+  bool Empty() const { return values.empty(); }
+  std::size_t Size() const { return values.size(); }
+
+  template <typename Engine>
+  std::int32_t Sample(Engine& random) const {
+    double x = std::uniform_real_distribution<double>(
+        0, static_cast<double>(values.size()))(random);
+    std::size_t i = static_cast<std::size_t>(x);
+    if (i >= values.size()) i = values.size() - 1;
+    return x - i < probabilities[i] ? values[i] : values[aliases[i]];
+  }
+};
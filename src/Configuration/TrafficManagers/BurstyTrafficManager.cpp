@@ -0,0 +1,104 @@
+#include "BurstyTrafficManager.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+BurstyTrafficManager::BurstyTrafficManager(
+    std::uint32_t seed, std::int32_t count,
+    std::unique_ptr<TrafficManager> traffic, double burst_length,
+    double duty_cycle)
+    : Random(seed + 1),
+      FireDistribution(0, 1),
+      GapDistributions(count),
+      States(count, {false, -1}),
+      Traffic(std::move(traffic)),
+      DutyCycle(duty_cycle),
+      OnRates(count) {
+  if (burst_length < 1)
+    throw std::runtime_error(
+        "BurstyTrafficManager error: Burst length can not be less than 1.");
+  if (duty_cycle <= 0 || duty_cycle > 1)
+    throw std::runtime_error(
+        "BurstyTrafficManager error: Duty cycle must be in (0, 1].");
+
+  // Dwell time of 1 + geometric(p) cycles has mean 1 / p
+  double idle_length = burst_length * (1 - duty_cycle) / duty_cycle;
+  if (idle_length > 0 && idle_length < 1)
+    throw std::runtime_error(
+        "BurstyTrafficManager error: Idle length can not be less than 1, "
+        "increase burst length or decrease duty cycle.");
+  OnDistribution = std::geometric_distribution<std::int64_t>(1 / burst_length);
+  if (idle_length > 0)
+    OffDistribution =
+        std::geometric_distribution<std::int64_t>(1 / idle_length);
+
+  for (std::int32_t i = 0; i < count; i++) {
+    double rate = Traffic->InjectionRate(i);
+    if (rate < 0)
+      throw std::runtime_error(
+          "BurstyTrafficManager error: Traffic distribution has no constant "
+          "injection rate.");
+    OnRates[i] = rate / duty_cycle;
+    if (OnRates[i] > 1)
+      throw std::runtime_error(
+          "BurstyTrafficManager error: Injection rate can not be greater "
+          "than duty cycle.");
+    if (OnRates[i] > 0 && OnRates[i] < 1)
+      GapDistributions[i] =
+          std::geometric_distribution<std::int64_t>(OnRates[i]);
+  }
+}
+
+void BurstyTrafficManager::Advance(std::int32_t from, double time) const {
+  State& state = States[from];
+  if (state.end < 0) {
+    // Initial state is taken from stationary distribution
+    state.on = FireDistribution(Random) < DutyCycle;
+    state.end = time + 1 +
+                (state.on ? OnDistribution : OffDistribution)(Random);
+  }
+  while (state.end <= time) {
+    state.on = !state.on || DutyCycle >= 1;
+    state.end += 1 + (state.on ? OnDistribution : OffDistribution)(Random);
+  }
+}
+
+bool BurstyTrafficManager::FirePacket(std::int32_t from, double time) const {
+  Advance(from, time);
+  return States[from].on && FireDistribution(Random) < OnRates[from];
+}
+std::int32_t BurstyTrafficManager::FindDestination(std::int32_t from) const {
+  return Traffic->FindDestination(from);
+}
+double BurstyTrafficManager::NextPacketTime(std::int32_t from, double time,
+                                            double end) const {
+  if (OnRates[from] <= 0) return end;
+
+  // Injections are sampled geometrically within ON states, OFF states are
+  // skipped entirely
+  double t = time + 1;
+  while (t < end) {
+    Advance(from, t);
+    const State& state = States[from];
+    if (state.on) {
+      double next = t;
+      if (OnRates[from] < 1) next += GapDistributions[from](Random);
+      if (next < state.end) return std::min(next, end);
+    }
+    t = state.end;
+  }
+  return end;
+}
+double BurstyTrafficManager::InjectionRate(std::int32_t from) const {
+  return Traffic->InjectionRate(from);
+}
+bool BurstyTrafficManager::Multicast() const { return Traffic->Multicast(); }
+std::int32_t BurstyTrafficManager::FindDestinations(
+    std::int32_t from, double time, MulticastGroup& destinations) const {
+  return Traffic->FindDestinations(from, time, destinations);
+}
+void BurstyTrafficManager::PacketReceived(std::int32_t node,
+                                          std::int32_t message,
+                                          double time) const {
+  Traffic->PacketReceived(node, message, time);
+}
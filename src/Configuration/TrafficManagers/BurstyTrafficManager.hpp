@@ -0,0 +1,51 @@
+#pragma once
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "TrafficManager.hpp"
+
+// Two state Markov modulated injection on top of traffic with constant
+// injection rate. Each node alternates between ON and OFF states with
+// geometric dwell times and injects only in ON state, so its mean rate is
+// kept while packets come in bursts. Destinations are chosen by the
+// underlying traffic.
+class BurstyTrafficManager : public TrafficManager {
+ private:
+  struct State {
+    bool on;
+    double end;  // Cycle at which the state changes
+  };
+
+  mutable std::default_random_engine Random;
+  mutable std::uniform_real_distribution<double> FireDistribution;
+  mutable std::geometric_distribution<std::int64_t> OnDistribution;
+  mutable std::geometric_distribution<std::int64_t> OffDistribution;
+  mutable std::vector<std::geometric_distribution<std::int64_t>>
+      GapDistributions;
+  mutable std::vector<State> States;
+
+  const std::unique_ptr<TrafficManager> Traffic;
+  const double DutyCycle;
+  std::vector<double> OnRates;  // Injection probability in ON state
+
+  void Advance(std::int32_t from, double time) const;
+
+ public:
+  BurstyTrafficManager(std::uint32_t seed, std::int32_t count,
+                       std::unique_ptr<TrafficManager> traffic,
+                       double burst_length, double duty_cycle);
+
+  bool FirePacket(std::int32_t from, double time) const override;
+  std::int32_t FindDestination(std::int32_t from) const override;
+  double NextPacketTime(std::int32_t from, double time,
+                        double end) const override;
+  double InjectionRate(std::int32_t from) const override;
+  // Underlying traffic which chooses destinations
+  const TrafficManager& Distribution() const { return *Traffic; }
+  bool Multicast() const override;
+  std::int32_t FindDestinations(std::int32_t from, double time,
+                                MulticastGroup& destinations) const override;
+  void PacketReceived(std::int32_t node, std::int32_t message,
+                      double time) const override;
+};
@@ -1,22 +1,60 @@
 #include "HotspotTrafficManager.hpp"
 
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
 HotspotTrafficManager::HotspotTrafficManager(
     std::uint32_t seed, std::int32_t count, double pir,
-    const std::vector<
-        std::pair<std::int32_t, std::pair<std::int32_t, std::int32_t>>>&
+    const std::vector<std::pair<std::int32_t, std::pair<double, double>>>&
         hotspots)
     : Random(seed),
+      FireDistribution(0, 1),
       PacketInjectionRate(pir),
-      TrafficLoad(count, std::make_pair(1, 1)) {
-  for (const auto& hotspot : hotspots)
+      TrafficLoad(count, std::make_pair(1.0, 1.0)),
+      ExclusiveDestinations(count) {
+  for (const auto& hotspot : hotspots) {
+    if (hotspot.first < 0 || hotspot.first >= count)
+      throw std::runtime_error("HotspotTrafficManager error: Invalid node [" +
+                               std::to_string(hotspot.first) + "].");
     TrafficLoad[hotspot.first] = hotspot.second;
+  }
+
+  std::vector<std::int32_t> nodes(count);
+  std::iota(nodes.begin(), nodes.end(), 0);
+  std::vector<double> weights(count);
+  double total = 0;
+  for (std::int32_t i = 0; i < count; i++) {
+    weights[i] = TrafficLoad[i].second;
+    total += weights[i];
+  }
+  Destinations = AliasTable(nodes, weights);
+  if (Destinations.Size() < 2)
+    throw std::runtime_error(
+        "HotspotTrafficManager error: At least two nodes must have positive "
+        "receive factor.");
+
+  for (std::int32_t i = 0; i < count; i++) {
+    double weight = weights[i];
+    if (weight > 0 && 2 * weight >= total) {
+      weights[i] = 0;
+      ExclusiveDestinations[i] = AliasTable(nodes, weights);
+      weights[i] = weight;
+    }
+  }
+
+  GapDistributions.resize(TrafficLoad.size());
+  for (std::int32_t i = 0; i < TrafficLoad.size(); i++) {
+    double p = FireProbability(i);
+    if (p > 0 && p < 1)
+      GapDistributions[i] = std::geometric_distribution<std::int64_t>(p);
+  }
+}
 
-  for (std::int32_t i = 0; i < TrafficLoad.size(); i++)
-    for (std::int32_t j = 0; j < TrafficLoad[i].second; j++)
-      Destinations.push_back(i);
-  DestDistribution =
-      std::uniform_int_distribution<std::int32_t>(0, Destinations.size() - 1);
-  FireDistribution = std::uniform_real_distribution<double>(0, 1);
+double HotspotTrafficManager::FireProbability(std::int32_t from) const {
+  if (TrafficLoad[from].first <= 0) return PacketInjectionRate > 0 ? 1 : 0;
+  return PacketInjectionRate / TrafficLoad[from].first;
 }
 
 bool HotspotTrafficManager::FirePacket(std::int32_t from, double time) const {
@@ -24,8 +62,21 @@ bool HotspotTrafficManager::FirePacket(std::int32_t from, double time) const {
          PacketInjectionRate;
 }
 std::int32_t HotspotTrafficManager::FindDestination(std::int32_t from) const {
+  const AliasTable& exclusive = ExclusiveDestinations[from];
+  if (!exclusive.Empty()) return exclusive.Sample(Random);
+
   std::int32_t destination;
-  while ((destination = Destinations[DestDistribution(Random)]) == from)
+  while ((destination = Destinations.Sample(Random)) == from)
     ;
   return destination;
-}
\ No newline at end of file
+}
+double HotspotTrafficManager::NextPacketTime(std::int32_t from, double time,
+                                             double end) const {
+  double p = FireProbability(from);
+  if (p <= 0) return end;
+  if (p >= 1) return std::min(time + 1, end);
+  return std::min(time + 1 + GapDistributions[from](Random), end);
+}
+double HotspotTrafficManager::InjectionRate(std::int32_t from) const {
+  return std::min(1.0, FireProbability(from));
+}
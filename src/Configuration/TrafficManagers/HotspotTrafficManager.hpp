@@ -1,25 +1,35 @@
 #pragma once
 #include <random>
 
+#include "AliasTable.hpp"
 #include "TrafficManager.hpp"
 
 class HotspotTrafficManager : public TrafficManager {
  private:
   mutable std::default_random_engine Random;
-  std::uniform_int_distribution<std::int32_t> DestDistribution;
-  std::uniform_real_distribution<double> FireDistribution;
+  mutable std::uniform_real_distribution<double> FireDistribution;
+  mutable std::vector<std::geometric_distribution<std::int64_t>>
+      GapDistributions;
   const double PacketInjectionRate;
 
-  std::vector<std::pair<std::int32_t, std::int32_t>> TrafficLoad;
-  std::vector<std::int32_t> Destinations;
+  std::vector<std::pair<double, double>> TrafficLoad;
+  // Destinations of all sources weighted by receive factors. Sources which
+  // take at least half of the total weight get own table without themselves,
+  // others reject self with probability below one half.
+  AliasTable Destinations;
+  std::vector<AliasTable> ExclusiveDestinations;
+
+  double FireProbability(std::int32_t from) const;
 
  public:
   HotspotTrafficManager(
       std::uint32_t seed, std::int32_t count, double pir,
-      const std::vector<
-          std::pair<std::int32_t, std::pair<std::int32_t, std::int32_t>>>&
+      const std::vector<std::pair<std::int32_t, std::pair<double, double>>>&
           hotspots);
 
   virtual bool FirePacket(std::int32_t from, double time) const override;
   virtual std::int32_t FindDestination(std::int32_t from) const override;
-};
\ No newline at end of file
+  virtual double NextPacketTime(std::int32_t from, double time,
+                                double end) const override;
+  virtual double InjectionRate(std::int32_t from) const override;
+};
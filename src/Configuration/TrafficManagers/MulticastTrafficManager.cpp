@@ -0,0 +1,102 @@
+#include "MulticastTrafficManager.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+MulticastTrafficManager::MulticastTrafficManager(std::uint32_t seed,
+                                                 std::int32_t count,
+                                                 double pir,
+                                                 std::int32_t group_size,
+                                                 double reset_time)
+    : Random(seed),
+      FireDistribution(0, 1),
+      PacketInjectionRate(pir),
+      GroupSize(group_size),
+      Offset(reset_time) {
+  if (group_size < 1 || group_size >= count)
+    throw std::runtime_error(
+        "MulticastTrafficManager error: Invalid multicast size [" +
+        std::to_string(group_size) + "] for [" + std::to_string(count) +
+        "] nodes.");
+  if (pir > 0 && pir < 1)
+    GapDistribution = std::geometric_distribution<std::int64_t>(pir);
+
+  if (group_size == count - 1) {
+    // Broadcast groups do not change, so they are shared by all packets
+    for (std::int32_t from = 0; from < count; from++) {
+      std::vector<std::int32_t> group;
+      for (std::int32_t i = 0; i < count; i++) {
+        if (i != from) group.push_back(i);
+      }
+      Broadcast.push_back(
+          std::make_shared<const std::vector<std::int32_t>>(std::move(group)));
+    }
+  }
+  for (std::int32_t i = 0; i < count; i++) Nodes.push_back(i);
+}
+
+bool MulticastTrafficManager::FirePacket(std::int32_t from,
+                                         double time) const {
+  return FireDistribution(Random) < PacketInjectionRate;
+}
+std::int32_t MulticastTrafficManager::FindDestination(
+    std::int32_t from) const {
+  throw std::runtime_error(
+      "MulticastTrafficManager error: Packets have multiple destinations.");
+}
+double MulticastTrafficManager::NextPacketTime(std::int32_t from, double time,
+                                               double end) const {
+  if (PacketInjectionRate <= 0) return end;
+  if (PacketInjectionRate >= 1) return std::min(time + 1, end);
+  return std::min(time + 1 + GapDistribution(Random), end);
+}
+double MulticastTrafficManager::InjectionRate(std::int32_t from) const {
+  return PacketInjectionRate;
+}
+
+std::int32_t MulticastTrafficManager::FindDestinations(
+    std::int32_t from, double time, MulticastGroup& destinations) const {
+  if (!Broadcast.empty()) {
+    destinations = Broadcast[from];
+  } else {
+    // Partial Fisher-Yates shuffle over nodes except the source, which is
+    // kept at the end
+    std::int32_t last = Nodes.size() - 1;
+    std::swap(*std::find(Nodes.begin(), Nodes.end(), from), Nodes[last]);
+    for (std::int32_t i = 0; i < GroupSize; i++) {
+      std::uniform_int_distribution<std::int32_t> pick(i, last - 1);
+      std::swap(Nodes[i], Nodes[pick(Random)]);
+    }
+    destinations = std::make_shared<const std::vector<std::int32_t>>(
+        Nodes.begin(), Nodes.begin() + GroupSize);
+  }
+
+  std::int32_t message;
+  if (FreeSlots.empty()) {
+    message = Deliveries.size();
+    Deliveries.push_back({});
+  } else {
+    message = FreeSlots.back();
+    FreeSlots.pop_back();
+  }
+  Deliveries[message] = {time, GroupSize};
+  return message;
+}
+void MulticastTrafficManager::PacketReceived(std::int32_t node,
+                                             std::int32_t message,
+                                             double time) const {
+  Delivery& delivery = Deliveries[message];
+  if (--delivery.pending) return;
+
+  FreeSlots.push_back(message);
+  if (delivery.timestamp < Offset) return;
+  double delay = time - delivery.timestamp;
+  TotalDelivered++;
+  TotalDeliveryDelay += delay;
+  MaxDeliveryDelay = std::max(MaxDeliveryDelay, delay);
+}
+
+double MulticastTrafficManager::AverageDeliveryDelay() const {
+  return TotalDeliveryDelay / TotalDelivered;
+}
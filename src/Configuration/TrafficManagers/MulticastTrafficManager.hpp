@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "TrafficManager.hpp"
+
+// Uniform injection of multicast packets. Each packet is delivered to the
+// given number of distinct random nodes other than its source, or to all
+// other nodes in broadcast case. Delivery of each packet is tracked until
+// its last destination receives the tail flit.
+class MulticastTrafficManager : public TrafficManager {
+ private:
+  struct Delivery {
+    double timestamp;      // Creation time
+    std::int32_t pending;  // Destinations left, 0 for free slot
+  };
+
+  mutable std::default_random_engine Random;
+  mutable std::uniform_real_distribution<double> FireDistribution;
+  mutable std::geometric_distribution<std::int64_t> GapDistribution;
+  const double PacketInjectionRate;
+  const std::int32_t GroupSize;
+  const double Offset;  // System time of simulation start
+
+  std::vector<MulticastGroup> Broadcast;  // Groups by source in broadcast
+  mutable std::vector<std::int32_t> Nodes;  // Permutation for sampling
+
+  mutable std::vector<Delivery> Deliveries;  // By message id
+  mutable std::vector<std::int32_t> FreeSlots;
+
+  mutable std::size_t TotalDelivered = 0;
+  mutable double TotalDeliveryDelay = 0;
+  mutable double MaxDeliveryDelay = 0;
+
+ public:
+  MulticastTrafficManager(std::uint32_t seed, std::int32_t count, double pir,
+                          std::int32_t group_size, double reset_time);
+
+  bool FirePacket(std::int32_t from, double time) const override;
+  std::int32_t FindDestination(std::int32_t from) const override;
+  double NextPacketTime(std::int32_t from, double time,
+                        double end) const override;
+  double InjectionRate(std::int32_t from) const override;
+
+  bool Multicast() const override { return true; }
+  std::int32_t FindDestinations(std::int32_t from, double time,
+                                MulticastGroup& destinations) const override;
+  void PacketReceived(std::int32_t node, std::int32_t message,
+                      double time) const override;
+
+  std::int32_t Size() const { return GroupSize; }
+  // Packets created after simulation start and received by all destinations
+  std::size_t Delivered() const { return TotalDelivered; }
+  // Delay from creation to reception by the last destination
+  double AverageDeliveryDelay() const;
+  double MaxDelay() const { return MaxDeliveryDelay; }
+};
@@ -0,0 +1,115 @@
+#include "PermutationTrafficManager.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+const std::vector<std::string> PermutationTrafficManager::Patterns = {
+    "TRAFFIC_TRANSPOSE", "TRAFFIC_BIT_COMPLEMENT", "TRAFFIC_BIT_REVERSE",
+    "TRAFFIC_SHUFFLE",   "TRAFFIC_TORNADO",        "TRAFFIC_NEIGHBOUR",
+    "TRAFFIC_RANDOM_PERMUTATION"};
+
+static std::int32_t Bits(std::int32_t count, const std::string& pattern) {
+  std::int32_t bits = 0;
+  while ((1 << bits) < count) bits++;
+  if ((1 << bits) != count)
+    throw std::runtime_error("PermutationTrafficManager error: Pattern [" +
+                             pattern + "] requires power of two nodes.");
+  return bits;
+}
+
+std::vector<std::int32_t> PermutationTrafficManager::MakePattern(
+    const std::string& pattern, std::int32_t dim_x, std::int32_t dim_y,
+    std::uint32_t seed) {
+  const std::int32_t count = dim_x * dim_y;
+  std::vector<std::int32_t> destinations(count);
+
+  if (pattern == "TRAFFIC_TRANSPOSE") {
+    if (dim_x == dim_y) {
+      for (std::int32_t i = 0; i < count; i++)
+        destinations[i] = (i % dim_x) * dim_x + i / dim_x;
+    } else {
+      // Swap of upper and lower halves of node index bits
+      std::int32_t bits = Bits(count, pattern);
+      if (bits % 2)
+        throw std::runtime_error(
+            "PermutationTrafficManager error: Pattern [" + pattern +
+            "] requires square grid or power of four nodes.");
+      std::int32_t half = bits / 2, mask = (1 << half) - 1;
+      for (std::int32_t i = 0; i < count; i++)
+        destinations[i] = ((i & mask) << half) | (i >> half);
+    }
+  } else if (pattern == "TRAFFIC_BIT_COMPLEMENT") {
+    for (std::int32_t i = 0; i < count; i++)
+      destinations[i] = count - 1 - i;
+  } else if (pattern == "TRAFFIC_BIT_REVERSE") {
+    std::int32_t bits = Bits(count, pattern);
+    for (std::int32_t i = 0; i < count; i++) {
+      std::int32_t reversed = 0;
+      for (std::int32_t b = 0; b < bits; b++)
+        reversed |= ((i >> b) & 1) << (bits - 1 - b);
+      destinations[i] = reversed;
+    }
+  } else if (pattern == "TRAFFIC_SHUFFLE") {
+    std::int32_t bits = Bits(count, pattern);
+    for (std::int32_t i = 0; i < count; i++)
+      destinations[i] = ((i << 1) | (i >> (bits - 1))) & (count - 1);
+  } else if (pattern == "TRAFFIC_TORNADO" || pattern == "TRAFFIC_NEIGHBOUR") {
+    // Shift by half of dimension minus one or by one along each dimension
+    bool tornado = pattern == "TRAFFIC_TORNADO";
+    std::int32_t shift_x = tornado ? (dim_x + 1) / 2 - 1 : 1;
+    std::int32_t shift_y = tornado ? (dim_y + 1) / 2 - 1 : 1;
+    if (dim_y == 1) shift_y = 0;
+    for (std::int32_t i = 0; i < count; i++) {
+      std::int32_t x = (i % dim_x + shift_x) % dim_x;
+      std::int32_t y = (i / dim_x + shift_y) % dim_y;
+      destinations[i] = y * dim_x + x;
+    }
+  } else if (pattern == "TRAFFIC_RANDOM_PERMUTATION") {
+    // Sattolo's algorithm, resulting permutation has no fixed points
+    std::default_random_engine random(seed);
+    std::iota(destinations.begin(), destinations.end(), 0);
+    for (std::int32_t i = count - 1; i > 0; i--) {
+      std::int32_t j =
+          std::uniform_int_distribution<std::int32_t>(0, i - 1)(random);
+      std::swap(destinations[i], destinations[j]);
+    }
+  } else {
+    throw std::runtime_error(
+        "PermutationTrafficManager error: Invalid pattern [" + pattern +
+        "].");
+  }
+
+  return destinations;
+}
+
+PermutationTrafficManager::PermutationTrafficManager(
+    std::uint32_t seed, std::int32_t dim_x, std::int32_t dim_y, double pir,
+    const std::string& pattern)
+    : Random(seed),
+      FireDistribution(0, 1),
+      PacketInjectionRate(pir),
+      Destinations(MakePattern(pattern, dim_x, dim_y, seed)) {
+  if (pir > 0 && pir < 1)
+    GapDistribution = std::geometric_distribution<std::int64_t>(pir);
+}
+
+bool PermutationTrafficManager::FirePacket(std::int32_t from,
+                                           double time) const {
+  return Destinations[from] != from &&
+         FireDistribution(Random) < PacketInjectionRate;
+}
+std::int32_t PermutationTrafficManager::FindDestination(
+    std::int32_t from) const {
+  return Destinations[from];
+}
+double PermutationTrafficManager::NextPacketTime(std::int32_t from,
+                                                 double time,
+                                                 double end) const {
+  if (PacketInjectionRate <= 0 || Destinations[from] == from) return end;
+  if (PacketInjectionRate >= 1) return std::min(time + 1, end);
+  return std::min(time + 1 + GapDistribution(Random), end);
+}
+double PermutationTrafficManager::InjectionRate(std::int32_t from) const {
+  return Destinations[from] != from ? PacketInjectionRate : 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <random>
+#include <string>
+#include <vector>
+
+#include "TrafficManager.hpp"
+
+// Each node sends packets to the single destination given by permutation
+// pattern. Nodes are placed on dim_x * dim_y grid, destinations are
+// precomputed at construction. Nodes mapped to themselves do not send.
+class PermutationTrafficManager : public TrafficManager {
+ private:
+  mutable std::default_random_engine Random;
+  mutable std::uniform_real_distribution<double> FireDistribution;
+  mutable std::geometric_distribution<std::int64_t> GapDistribution;
+  const double PacketInjectionRate;
+
+  std::vector<std::int32_t> Destinations;
+
+ public:
+  // Supported values of traffic_distribution
+  static const std::vector<std::string> Patterns;
+
+  PermutationTrafficManager(std::uint32_t seed, std::int32_t dim_x,
+                            std::int32_t dim_y, double pir,
+                            const std::string& pattern);
+
+  static std::vector<std::int32_t> MakePattern(const std::string& pattern,
+                                               std::int32_t dim_x,
+                                               std::int32_t dim_y,
+                                               std::uint32_t seed);
+
+  virtual bool FirePacket(std::int32_t from, double time) const override;
+  virtual std::int32_t FindDestination(std::int32_t from) const override;
+  virtual double NextPacketTime(std::int32_t from, double time,
+                                double end) const override;
+  virtual double InjectionRate(std::int32_t from) const override;
+};
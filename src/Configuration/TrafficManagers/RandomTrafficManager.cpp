@@ -1,11 +1,16 @@
 #include "RandomTrafficManager.hpp"
 
+#include <algorithm>
+
 RandomTrafficManager::RandomTrafficManager(std::uint32_t seed,
                                            std::int32_t count, double pir)
     : Random(seed),
       DestDistribution(0, count - 1),
       FireDistribution(0, 1),
-      PacketInjectionRate(pir) {}
+      PacketInjectionRate(pir) {
+  if (pir > 0 && pir < 1)
+    GapDistribution = std::geometric_distribution<std::int64_t>(pir);
+}
 
 bool RandomTrafficManager::FirePacket(std::int32_t from, double time) const {
   return FireDistribution(Random) < PacketInjectionRate;
@@ -15,4 +20,14 @@ std::int32_t RandomTrafficManager::FindDestination(std::int32_t from) const {
   while ((destination = DestDistribution(Random)) == from)
     ;
   return destination;
-}
\ No newline at end of file
+}
+double RandomTrafficManager::NextPacketTime(std::int32_t from, double time,
+                                            double end) const {
+  // Gap between successes of per cycle Bernoulli trials is geometric
+  if (PacketInjectionRate <= 0) return end;
+  if (PacketInjectionRate >= 1) return std::min(time + 1, end);
+  return std::min(time + 1 + GapDistribution(Random), end);
+}
+double RandomTrafficManager::InjectionRate(std::int32_t from) const {
+  return PacketInjectionRate;
+}
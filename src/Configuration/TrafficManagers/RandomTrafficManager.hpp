@@ -6,8 +6,9 @@
 class RandomTrafficManager : public TrafficManager {
  private:
   mutable std::default_random_engine Random;
-  std::uniform_int_distribution<std::int32_t> DestDistribution;
-  std::uniform_real_distribution<double> FireDistribution;
+  mutable std::uniform_int_distribution<std::int32_t> DestDistribution;
+  mutable std::uniform_real_distribution<double> FireDistribution;
+  mutable std::geometric_distribution<std::int64_t> GapDistribution;
   const double PacketInjectionRate;
 
  public:
@@ -15,4 +16,7 @@ class RandomTrafficManager : public TrafficManager {
 
   virtual bool FirePacket(std::int32_t from, double time) const override;
   virtual std::int32_t FindDestination(std::int32_t from) const override;
+  virtual double NextPacketTime(std::int32_t from, double time,
+                                double end) const override;
+  virtual double InjectionRate(std::int32_t from) const override;
 };
\ No newline at end of file
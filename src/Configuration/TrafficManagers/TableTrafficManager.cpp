@@ -1,91 +1,194 @@
 #include "TableTrafficManager.hpp"
 
-#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 
-TableTrafficManager::TableTrafficManager(std::uint32_t seed, std::int32_t count,
-                                         const std::string& file,
-                                         double default_pir,
-                                         double total_global_time)
-    : Random(seed), DestDistribution(0, count - 1), FireDistribution(0, 1) {
-  // Open file
+#include "Configuration/MappedFile.hpp"
+
+constexpr char TableTrafficManager::BinaryMagic[8];
+
+bool TableTrafficManager::Communication::Active(double time) const {
+  std::int32_t r_ccycle = static_cast<std::int64_t>(time) % t_period;
+  return r_ccycle > t_on && r_ccycle < t_off;
+}
+double TableTrafficManager::Communication::NextChange(double time) const {
+  std::int32_t r_ccycle = static_cast<std::int64_t>(time) % t_period;
+  if (r_ccycle <= t_on) return time + (t_on + 1 - r_ccycle);
+  if (r_ccycle < t_off) return time + (t_off - r_ccycle);
+  return time + (t_period - r_ccycle) + t_on + 1;
+}
+
+void TableTrafficManager::AddCommunication(std::int32_t src, std::int32_t dst,
+                                           double pir, std::int32_t t_on,
+                                           std::int32_t t_off,
+                                           std::int32_t t_period) {
+  if (src < 0 || src >= Sources.size() || dst < 0 || dst >= Sources.size())
+    throw std::runtime_error(
+        "TableTrafficManager error: Invalid communication [" +
+        std::to_string(src) + " -> " + std::to_string(dst) + "].");
+
+  Communication communication;
+  communication.dst = dst;
+
+  // Custom PIR
+  communication.pir = pir >= 0 && pir <= 1 ? pir : DefaultPIR;
+  // Custom Ton
+  communication.t_on = t_on >= 0 ? t_on : 0;
+  // Custom Toff
+  communication.t_off = t_off >= 0 ? t_off : TotalGlobalTime;
+  // Custom Tperiod
+  communication.t_period = t_period > 0 ? t_period : TotalGlobalTime;
+
+  if (communication.t_off <= communication.t_on ||
+      communication.t_period < communication.t_off)
+    throw std::runtime_error(
+        "TableTrafficManager error: Invalid activity window of communication "
+        "[" +
+        std::to_string(src) + " -> " + std::to_string(dst) + "].");
+
+  Sources[src].communications.push_back(communication);
+}
+
+void TableTrafficManager::LoadText(const std::string& file) {
   std::ifstream fin(file, std::ios::in);
   if (!fin)
     throw std::runtime_error("TableTrafficManager error: File [" + file +
                              "] does not exsits.");
 
-  // Initialize variables
-  TrafficTable.clear();
-
-  // Cycle reading file
-  while (!fin.eof()) {
-    char line[512];
-    fin.getline(line, sizeof(line) - 1);
-
-    if (line[0] != '\0') {
-      if (line[0] != '%') {
-        int src, dst;  // Mandatory
-        double pir, por;
-        int t_on, t_off, t_period;
-
-        int params = sscanf(line, "%d %d %lf %lf %d %d %d", &src, &dst, &pir,
-                            &por, &t_on, &t_off, &t_period);
-        if (params >= 2) {
-          // Create a communication from the parameters read on the line
-          Communication communication;
-
-          // Mandatory fields
-          communication.src = src;
-          communication.dst = dst;
-
-          // Custom PIR
-          if (params >= 3 && pir >= 0 && pir <= 1)
-            communication.pir = pir;
-          else
-            communication.pir = default_pir;
-
-          // Custom Ton
-          if (params >= 4 && t_on >= 0)
-            communication.t_on = t_on;
-          else
-            communication.t_on = 0;
-
-          // Custom Toff
-          if (params >= 5 && t_off >= 0) {
-            assert(t_off > t_on);
-            communication.t_off = t_off;
-          } else
-            communication.t_off = total_global_time;
-
-          // Custom Tperiod
-          if (params >= 6 && t_period > 0) {
-            assert(t_period > t_off);
-            communication.t_period = t_period;
-          } else
-            communication.t_period = total_global_time;
-
-          // Add this communication to the vector of communications
-          TrafficTable.push_back(communication);
-        }
-      }
+  std::string line;
+  while (std::getline(fin, line)) {
+    if (line.empty() || line[0] == '%') continue;
+
+    int src, dst;  // Mandatory
+    double pir, por;
+    int t_on, t_off, t_period;
+
+    int params = sscanf(line.c_str(), "%d %d %lf %lf %d %d %d", &src, &dst,
+                        &pir, &por, &t_on, &t_off, &t_period);
+    if (params >= 2) {
+      AddCommunication(src, dst, params >= 3 ? pir : -1,
+                       params >= 5 ? t_on : -1, params >= 6 ? t_off : -1,
+                       params >= 7 ? t_period : -1);
     }
   }
 }
+void TableTrafficManager::LoadBinary(const std::string& file) {
+  MappedFile mapping(file);
 
-bool TableTrafficManager::FirePacket(std::int32_t from, double time) const {
-  double threshold = 0.0;
-  for (const Communication& comm : TrafficTable) {
-    if (comm.src == from) {
-      int r_ccycle = static_cast<std::int32_t>(time) % comm.t_period;
-      if (r_ccycle > comm.t_on && r_ccycle < comm.t_off) threshold += comm.pir;
+  BinaryHeader header;
+  if (mapping.Size() >= sizeof(header))
+    std::memcpy(&header, mapping.Data(), sizeof(header));
+  if (mapping.Size() < sizeof(header) ||
+      (mapping.Size() - sizeof(header)) / sizeof(BinaryRecord) < header.count)
+    throw std::runtime_error("TableTrafficManager error: File [" + file +
+                             "] is truncated.");
+
+  const char* records = mapping.Data() + sizeof(BinaryHeader);
+  for (std::uint64_t i = 0; i < header.count; i++) {
+    BinaryRecord record;
+    std::memcpy(&record, records + i * sizeof(BinaryRecord), sizeof(record));
+    AddCommunication(record.src, record.dst, record.pir, record.t_on,
+                     record.t_off, record.t_period);
+  }
+}
+
+TableTrafficManager::TableTrafficManager(std::uint32_t seed, std::int32_t count,
+                                         const std::string& file,
+                                         double default_pir,
+                                         double total_global_time)
+    : Random(seed),
+      DestDistribution(0, count - 1),
+      FireDistribution(0, 1),
+      Sources(count),
+      FireTimes(count, 0),
+      DefaultPIR(default_pir),
+      TotalGlobalTime(total_global_time) {
+  // Binary tables are recognized by their header
+  char magic[sizeof(BinaryMagic)] = {};
+  std::ifstream(file, std::ios::in | std::ios::binary)
+      .read(magic, sizeof(magic));
+  if (std::equal(magic, magic + sizeof(magic), BinaryMagic))
+    LoadBinary(file);
+  else
+    LoadText(file);
+
+  // Destinations are chosen with probability of the share of packets
+  // each active communication produces. Communications with the same
+  // window are active together, so constant alias table is used for them.
+  for (auto& source : Sources) {
+    std::vector<std::int32_t> destinations;
+    std::vector<double> weights;
+    for (const auto& comm : source.communications) {
+      const auto& first = source.communications.front();
+      source.windowed |= comm.t_on != first.t_on ||
+                         comm.t_off != first.t_off ||
+                         comm.t_period != first.t_period;
+      destinations.push_back(comm.dst);
+      weights.push_back(comm.pir);
     }
+    source.destinations = AliasTable(destinations, weights);
+  }
+}
+
+double TableTrafficManager::Threshold(std::int32_t from, double time) const {
+  double threshold = 0.0;
+  for (const Communication& comm : Sources[from].communications) {
+    if (comm.Active(time)) threshold += comm.pir;
   }
+  return threshold;
+}
 
-  return (FireDistribution(Random) < threshold);
+bool TableTrafficManager::FirePacket(std::int32_t from, double time) const {
+  bool fired = FireDistribution(Random) < Threshold(from, time);
+  if (fired) FireTimes[from] = time;
+  return fired;
 }
 std::int32_t TableTrafficManager::FindDestination(std::int32_t from) const {
+  const Source& source = Sources[from];
+  if (source.windowed) {
+    double time = FireTimes[from];
+    double choice = FireDistribution(Random) * Threshold(from, time);
+    std::int32_t last = -1;
+    for (const Communication& comm : source.communications) {
+      if (!comm.Active(time) || comm.pir <= 0) continue;
+      last = comm.dst;
+      choice -= comm.pir;
+      if (choice < 0) return last;
+    }
+    if (last >= 0) return last;
+  }
+  const auto& destinations = source.destinations;
+  if (!destinations.Empty()) return destinations.Sample(Random);
+
   std::int32_t destination;
   while ((destination = DestDistribution(Random)) == from)
     ;
   return destination;
 }
+double TableTrafficManager::NextPacketTime(std::int32_t from, double time,
+                                           double end) const {
+  const auto& communications = Sources[from].communications;
+
+  // Threshold is constant between activity changes, so the gap is sampled
+  // geometrically within each such segment
+  double t = time + 1;
+  while (t < end) {
+    double threshold = 0.0;
+    double change = end;
+    for (const Communication& comm : communications) {
+      if (comm.Active(t)) threshold += comm.pir;
+      change = std::min(change, comm.NextChange(t));
+    }
+
+    if (threshold >= 1) return FireTimes[from] = t;
+    if (threshold > 0) {
+      double gap =
+          std::geometric_distribution<std::int64_t>(threshold)(Random);
+      if (t + gap < change) return FireTimes[from] = t + gap;
+    }
+    t = change;
+  }
+  return end;
+}
@@ -3,24 +3,65 @@
 #include <string>
 #include <cstdint>
 
+#include "AliasTable.hpp"
 #include "TrafficManager.hpp"
 
-// TODO: Rewrite this shit
 class TableTrafficManager : public TrafficManager {
+ public:
+  // Binary table file: header followed by records, fields are little endian.
+  // Negative pir and times mean default values.
+  struct BinaryHeader {
+    char magic[8];  // "NXTRAFFC"
+    std::uint64_t count;
+  };
+  struct BinaryRecord {
+    std::int32_t src;
+    std::int32_t dst;
+    float pir;
+    std::int32_t t_on;
+    std::int32_t t_off;
+    std::int32_t t_period;
+  };
+  static constexpr char BinaryMagic[8] = {'N', 'X', 'T', 'R',
+                                          'A', 'F', 'F', 'C'};
+
  private:
   mutable std::default_random_engine Random;
-  std::uniform_int_distribution<std::int32_t> DestDistribution;
-  std::uniform_real_distribution<double> FireDistribution;
+  mutable std::uniform_int_distribution<std::int32_t> DestDistribution;
+  mutable std::uniform_real_distribution<double> FireDistribution;
 
   struct Communication {
-    std::int32_t src;       // ID of the source node (PE)
     std::int32_t dst;       // ID of the destination node (PE)
     double pir;             // Packet Injection Rate for the link
     std::int32_t t_on;      // Time (in cycles) at which activity begins
     std::int32_t t_off;     // Time (in cycles) at which activity ends
     std::int32_t t_period;  // Period after which activity starts again
+
+    bool Active(double time) const;
+    double NextChange(double time) const;
   };
-  std::vector<Communication> TrafficTable;
+  struct Source {
+    std::vector<Communication> communications;
+    AliasTable destinations;  // Weighted by pir
+    // Communications have different activity windows, so destination is
+    // chosen among the ones active at fire time
+    bool windowed = false;
+  };
+  // Communications indexed by source node
+  std::vector<Source> Sources;
+  // Cycle of the last fired packet of each node
+  mutable std::vector<double> FireTimes;
+
+  const double DefaultPIR;
+  const double TotalGlobalTime;
+
+  void AddCommunication(std::int32_t src, std::int32_t dst, double pir,
+                        std::int32_t t_on, std::int32_t t_off,
+                        std::int32_t t_period);
+  void LoadText(const std::string& file);
+  void LoadBinary(const std::string& file);
+
+  double Threshold(std::int32_t from, double time) const;
 
  public:
   TableTrafficManager(std::uint32_t seed, std::int32_t count,
@@ -29,4 +70,6 @@ class TableTrafficManager : public TrafficManager {
 
   bool FirePacket(std::int32_t from, double time) const override;
   std::int32_t FindDestination(std::int32_t from) const override;
+  double NextPacketTime(std::int32_t from, double time,
+                        double end) const override;
 };
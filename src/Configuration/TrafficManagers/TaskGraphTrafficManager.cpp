@@ -0,0 +1,156 @@
+#include "TaskGraphTrafficManager.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+TaskGraphTrafficManager::TaskGraphTrafficManager(std::int32_t count,
+                                                 const std::string& file,
+                                                 double reset_time)
+    : Offset(reset_time), NodesFree(count, reset_time), Running(count) {
+  Load(file, count);
+
+  // Graph must be acyclic, otherwise some tasks never start
+  std::vector<std::int32_t> inputs(Tasks.size());
+  std::vector<std::int32_t> order;
+  for (std::int32_t t = 0; t < Tasks.size(); t++) {
+    inputs[t] = Tasks[t].inputs;
+    if (!inputs[t]) order.push_back(t);
+  }
+  for (std::size_t i = 0; i < order.size(); i++) {
+    for (std::int32_t m : Tasks[order[i]].outputs) {
+      if (!--inputs[Messages[m].dst]) order.push_back(Messages[m].dst);
+    }
+  }
+  if (order.size() != Tasks.size())
+    throw std::runtime_error("TaskGraphTrafficManager error: File [" + file +
+                             "] contains cyclic dependencies.");
+
+  for (std::int32_t t = 0; t < Tasks.size(); t++) {
+    if (!Tasks[t].inputs) Start(t, Offset);
+  }
+}
+
+void TaskGraphTrafficManager::Load(const std::string& file,
+                                   std::int32_t count) {
+  std::ifstream fin(file, std::ios::in);
+  if (!fin)
+    throw std::runtime_error("TaskGraphTrafficManager error: File [" + file +
+                             "] does not exsits.");
+
+  std::string line;
+  for (std::size_t number = 1; std::getline(fin, line); number++) {
+    std::istringstream stream(line);
+    std::string kind;
+    if (!(stream >> kind) || kind[0] == '%') continue;
+
+    bool valid = false;
+    if (kind == "task") {
+      std::int32_t id, node;
+      double compute;
+      if (stream >> id >> node >> compute && id >= 0 && node >= 0 &&
+          node < count && compute >= 0) {
+        if (id >= Tasks.size()) Tasks.resize(id + 1, {-1, 0, 0, -1, {}});
+        valid = Tasks[id].node < 0;
+        Tasks[id].node = node;
+        Tasks[id].compute = compute;
+      }
+    } else if (kind == "message") {
+      Message message;
+      if (stream >> message.src >> message.dst >> message.size &&
+          message.src >= 0 && message.dst >= 0 && message.src != message.dst &&
+          message.size > 0) {
+        Messages.push_back(message);
+        valid = true;
+      }
+    }
+    if (!valid)
+      throw std::runtime_error("TaskGraphTrafficManager error: Invalid line [" +
+                               std::to_string(number) + "] in file [" + file +
+                               "].");
+  }
+
+  for (std::int32_t m = 0; m < Messages.size(); m++) {
+    const Message& message = Messages[m];
+    if (std::max(message.src, message.dst) >= Tasks.size() ||
+        Tasks[message.src].node < 0 || Tasks[message.dst].node < 0)
+      throw std::runtime_error(
+          "TaskGraphTrafficManager error: Message of undefined task in file "
+          "[" +
+          file + "].");
+    Tasks[message.src].outputs.push_back(m);
+    Tasks[message.dst].inputs++;
+  }
+  for (std::int32_t t = 0; t < Tasks.size(); t++) {
+    if (Tasks[t].node < 0)
+      throw std::runtime_error("TaskGraphTrafficManager error: Task [" +
+                               std::to_string(t) +
+                               "] is not defined in file [" + file + "].");
+  }
+}
+
+void TaskGraphTrafficManager::Start(std::int32_t task, double time) const {
+  Task& t = Tasks[task];
+  double start = std::max(time, NodesFree[t.node]);
+  t.finish = NodesFree[t.node] = start + t.compute;
+  Running[t.node].push_back(task);
+}
+void TaskGraphTrafficManager::Deliver(std::int32_t message,
+                                      double time) const {
+  std::int32_t task = Messages[message].dst;
+  if (!--Tasks[task].inputs) Start(task, time);
+}
+
+bool TaskGraphTrafficManager::FirePacket(std::int32_t from,
+                                         double time) const {
+  return false;
+}
+std::int32_t TaskGraphTrafficManager::FindDestination(
+    std::int32_t from) const {
+  throw std::runtime_error(
+      "TaskGraphTrafficManager error: Destinations are defined by task graph.");
+}
+double TaskGraphTrafficManager::NextPacketTime(std::int32_t from, double time,
+                                               double end) const {
+  return end;
+}
+
+void TaskGraphTrafficManager::PacketsAt(std::int32_t from, double time,
+                                        std::vector<Packet>& packets) const {
+  auto& running = Running[from];
+  while (!running.empty() && Tasks[running.front()].finish <= time) {
+    const Task& task = Tasks[running.front()];
+    running.pop_front();
+
+    for (std::int32_t m : task.outputs) {
+      const Message& message = Messages[m];
+      std::int32_t node = Tasks[message.dst].node;
+      if (node == from) {
+        Deliver(m, task.finish);
+      } else {
+        packets.emplace_back(from, node, 0, task.finish, message.size);
+        packets.back().message_id = m;
+      }
+    }
+  }
+}
+void TaskGraphTrafficManager::PacketReceived(std::int32_t node,
+                                             std::int32_t message,
+                                             double time) const {
+  Deliver(message, time);
+}
+
+std::size_t TaskGraphTrafficManager::CompletedTasks(double time) const {
+  return std::count_if(Tasks.begin(), Tasks.end(), [&](const Task& task) {
+    return task.finish >= 0 && task.finish <= Offset + time;
+  });
+}
+double TaskGraphTrafficManager::Makespan(double time) const {
+  double makespan = 0;
+  for (const Task& task : Tasks) {
+    if (task.finish < 0 || task.finish > Offset + time) return -1;
+    makespan = std::max(makespan, task.finish - Offset);
+  }
+  return makespan;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "TrafficManager.hpp"
+
+// Application task graph. Each task is mapped to a node and computes for
+// given number of cycles once all its input messages are received, then
+// sends its output messages. Tasks of the same node are executed one at a
+// time in order of readiness. Messages between tasks of the same node do
+// not enter the network.
+class TaskGraphTrafficManager : public TrafficManager {
+ private:
+  struct Task {
+    std::int32_t node;
+    double compute;
+    std::int32_t inputs;  // Messages left to receive
+    double finish;        // Negative until task is started
+    std::vector<std::int32_t> outputs;
+  };
+  struct Message {
+    std::int32_t src;  // Tasks
+    std::int32_t dst;
+    std::int32_t size;
+  };
+
+  mutable std::vector<Task> Tasks;
+  std::vector<Message> Messages;
+  const double Offset;  // System time of simulation start
+
+  mutable std::vector<double> NodesFree;
+  mutable std::vector<std::deque<std::int32_t>> Running;  // Tasks by node
+
+  void Load(const std::string& file, std::int32_t count);
+  void Start(std::int32_t task, double time) const;
+  void Deliver(std::int32_t message, double time) const;
+
+ public:
+  TaskGraphTrafficManager(std::int32_t count, const std::string& file,
+                          double reset_time);
+
+  bool FirePacket(std::int32_t from, double time) const override;
+  std::int32_t FindDestination(std::int32_t from) const override;
+  double NextPacketTime(std::int32_t from, double time,
+                        double end) const override;
+
+  bool Batched() const override { return true; }
+  bool Closed() const override { return true; }
+  void PacketsAt(std::int32_t from, double time,
+                 std::vector<Packet>& packets) const override;
+  void PacketReceived(std::int32_t node, std::int32_t message,
+                      double time) const override;
+
+  std::size_t TotalTasks() const { return Tasks.size(); }
+  // Tasks finished before the given simulation time
+  std::size_t CompletedTasks(double time) const;
+  // Simulation time at which the last task finishes, negative if some tasks
+  // were not finished before the given simulation time
+  double Makespan(double time) const;
+};
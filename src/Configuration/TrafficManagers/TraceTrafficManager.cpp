@@ -0,0 +1,89 @@
+#include "TraceTrafficManager.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+constexpr char TraceTrafficManager::BinaryMagic[8];
+
+// Number of records after which replayed pages are released
+static constexpr std::uint64_t ReleasePeriod = 1 << 16;
+
+TraceTrafficManager::TraceTrafficManager(std::int32_t count,
+                                         const std::string& file,
+                                         double reset_time)
+    : Trace(file),
+      Count(0),
+      Offset(reset_time),
+      Cursor(0),
+      LastCycle(0),
+      Pending(count) {
+  BinaryHeader header;
+  if (Trace.Size() >= sizeof(header))
+    std::memcpy(&header, Trace.Data(), sizeof(header));
+  if (Trace.Size() < sizeof(header) ||
+      !std::equal(header.magic, header.magic + sizeof(header.magic),
+                  BinaryMagic))
+    throw std::runtime_error("TraceTrafficManager error: File [" + file +
+                             "] is not a packet trace.");
+  if ((Trace.Size() - sizeof(header)) / sizeof(BinaryRecord) < header.count)
+    throw std::runtime_error("TraceTrafficManager error: File [" + file +
+                             "] is truncated.");
+
+  Count = header.count;
+  Trace.AdviseSequential();
+}
+
+TraceTrafficManager::BinaryRecord TraceTrafficManager::Record(
+    std::uint64_t index) const {
+  BinaryRecord record;
+  std::memcpy(&record,
+              Trace.Data() + sizeof(BinaryHeader) +
+                  index * sizeof(BinaryRecord),
+              sizeof(record));
+  return record;
+}
+
+void TraceTrafficManager::Advance(double time) const {
+  for (; Cursor < Count; Cursor++) {
+    BinaryRecord record = Record(Cursor);
+    if (Offset + record.cycle > time) break;
+
+    if (record.cycle < LastCycle)
+      throw std::runtime_error(
+          "TraceTrafficManager error: Records are not sorted by cycle [" +
+          std::to_string(Cursor) + "].");
+    if (record.src < 0 || record.src >= Pending.size() || record.dst < 0 ||
+        record.dst >= Pending.size() || record.src == record.dst)
+      throw std::runtime_error(
+          "TraceTrafficManager error: Invalid record [" +
+          std::to_string(Cursor) + "].");
+
+    LastCycle = record.cycle;
+    Pending[record.src].emplace_back(record.src, record.dst, 0,
+                                     Offset + record.cycle, record.size);
+
+    if ((Cursor + 1) % ReleasePeriod == 0)
+      Trace.Release(sizeof(BinaryHeader) + Cursor * sizeof(BinaryRecord));
+  }
+}
+
+bool TraceTrafficManager::FirePacket(std::int32_t from, double time) const {
+  return false;
+}
+std::int32_t TraceTrafficManager::FindDestination(std::int32_t from) const {
+  throw std::runtime_error(
+      "TraceTrafficManager error: Destinations are defined by trace.");
+}
+double TraceTrafficManager::NextPacketTime(std::int32_t from, double time,
+                                           double end) const {
+  return end;
+}
+
+void TraceTrafficManager::PacketsAt(std::int32_t from, double time,
+                                    std::vector<Packet>& packets) const {
+  Advance(time);
+  auto& pending = Pending[from];
+  packets.insert(packets.end(), pending.begin(), pending.end());
+  pending.clear();
+}
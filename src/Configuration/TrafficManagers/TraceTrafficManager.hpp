@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Configuration/MappedFile.hpp"
+#include "TrafficManager.hpp"
+
+// Replays binary packet trace. File is memory mapped and records are
+// streamed in cycle order: only records of the current cycle are kept in
+// memory and pages already replayed are released.
+class TraceTrafficManager : public TrafficManager {
+ public:
+  // Binary trace file: header followed by records sorted by cycle, fields
+  // are little endian. Cycles are counted from the end of reset.
+  struct BinaryHeader {
+    char magic[8];  // "NXTRACE\0"
+    std::uint64_t count;
+  };
+  struct BinaryRecord {
+    std::uint64_t cycle;
+    std::int32_t src;
+    std::int32_t dst;
+    std::int32_t size;  // Flits, non-positive for random size
+    std::int32_t padding;
+  };
+  static constexpr char BinaryMagic[8] = {'N', 'X', 'T', 'R',
+                                          'A', 'C', 'E', '\0'};
+
+ private:
+  MappedFile Trace;
+  std::uint64_t Count;
+  const double Offset;  // System time of trace cycle 0
+
+  mutable std::uint64_t Cursor;
+  mutable std::uint64_t LastCycle;
+  mutable std::vector<std::vector<Packet>> Pending;  // Packets by source
+
+  BinaryRecord Record(std::uint64_t index) const;
+  void Advance(double time) const;
+
+ public:
+  TraceTrafficManager(std::int32_t count, const std::string& file,
+                      double reset_time);
+
+  bool FirePacket(std::int32_t from, double time) const override;
+  std::int32_t FindDestination(std::int32_t from) const override;
+  double NextPacketTime(std::int32_t from, double time,
+                        double end) const override;
+
+  bool Batched() const override { return true; }
+  void PacketsAt(std::int32_t from, double time,
+                 std::vector<Packet>& packets) const override;
+};
@@ -2,8 +2,48 @@
 #include <vector>
 #include <cstdint>
 
+#include "Data/Packet.hpp"
+
 class TrafficManager {
  public:
   virtual bool FirePacket(std::int32_t from, double time) const = 0;
   virtual std::int32_t FindDestination(std::int32_t from) const = 0;
-};
\ No newline at end of file
+
+  // Returns the cycle of the next packet injection from the given node after
+  // the given time, or end if there is no injection before it.
+  // Default implementation performs FirePacket trial for each cycle.
+  virtual double NextPacketTime(std::int32_t from, double time,
+                                double end) const {
+    for (double t = time + 1; t < end; t++) {
+      if (FirePacket(from, t)) return t;
+    }
+    return end;
+  }
+
+  // Returns mean per cycle packet injection probability of the given node,
+  // negative if it changes over time.
+  virtual double InjectionRate(std::int32_t from) const { return -1; }
+
+  // Batched managers produce complete packets instead of injection trials:
+  // PacketsAt is called by each node every cycle and appends packets
+  // produced by the node up to the given time. Packets with non-positive
+  // size get random size chosen by the node.
+  virtual bool Batched() const { return false; }
+  // Closed batched managers produce packets in response to received ones,
+  // so they are not stopped at the end of production time.
+  virtual bool Closed() const { return false; }
+  virtual void PacketsAt(std::int32_t from, double time,
+                         std::vector<Packet>& packets) const {}
+  // Multicast managers give destination list of each packet instead of
+  // FindDestination, returned message id of the packet created at the given
+  // time is reported by PacketReceived from every destination.
+  virtual bool Multicast() const { return false; }
+  virtual std::int32_t FindDestinations(std::int32_t from, double time,
+                                        MulticastGroup& destinations) const {
+    return -1;
+  }
+  // Called by the destination node when the tail flit of packet with
+  // non-negative message id is received.
+  virtual void PacketReceived(std::int32_t node, std::int32_t message,
+                              double time) const {}
+};
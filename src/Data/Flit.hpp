@@ -2,9 +2,14 @@
 #include <systemc.h>
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include "FlitType.hpp"
 
+// Destinations of multicast packet shared by its flits
+using MulticastGroup = std::shared_ptr<const std::vector<std::int32_t>>;
+
 struct Flit {
   std::uint64_t id;
   int src_id = -1;
@@ -16,8 +21,15 @@ struct Flit {
   int sequence_no = -1;
   int sequence_length = -1;
   double timestamp = -1;
+  double inject_timestamp = -1;
   double accept_timestamp = -1;
   int hop_no = -1;
+  double hop_timestamp = -1;  // Arrival to the current relay
+  double router_wait = 0;     // Queueing in routers beyond pipeline
+  double request_timestamp = -1;  // Closed loop reply, see Packet
+  int message_id = -1;
+  MulticastGroup multicast;  // Multicast destinations, dst_id is ignored
+  bool traced = false;       // Sampled by streaming flit tracer
 
   inline bool operator==(const Flit &flit) const {
     return flit.id == id && flit.src_id == src_id && flit.dst_id == dst_id &&
@@ -27,6 +39,8 @@ struct Flit {
            flit.timestamp == timestamp && flit.hop_no == hop_no;
   }
   bool valid() const { return flit_type != FlitType::None; }
+  // Number of destinations this copy of flit is delivered to
+  std::size_t Deliveries() const { return multicast ? multicast->size() : 1; }
 };
 
 void sc_trace(sc_trace_file *&tf, const Flit &flit, std::string &name);
@@ -3,21 +3,30 @@
 
 #include <cstdint>
 
+#include "Flit.hpp"
+
 struct Packet {
   std::int32_t src_id;
   std::int32_t dst_id;
   std::int32_t vc_id;
-  double timestamp;
+  double timestamp;         // Creation time
+  double inject_timestamp;  // Time head flit entered the network
   std::int32_t size;
   std::int32_t flit_left;
+  double request_timestamp;  // Timestamp of the request for reply packets
+  std::int32_t message_id;   // Message of batched traffic manager
+  MulticastGroup multicast;  // Destinations of multicast packet or nullptr
 
   Packet() {
     src_id = -1;
     dst_id = -1;
     vc_id = -1;
     timestamp = -1;
+    inject_timestamp = -1;
     size = -1;
     flit_left = -1;
+    request_timestamp = -1;
+    message_id = -1;
   }
   Packet(std::int32_t s, std::int32_t d, std::int32_t vc, double ts,
          std::int32_t sz) {
@@ -25,7 +34,10 @@ struct Packet {
     dst_id = d;
     vc_id = vc;
     timestamp = ts;
+    inject_timestamp = -1;
     size = sz;
     flit_left = sz;
+    request_timestamp = -1;
+    message_id = -1;
   }
 };
@@ -1,5 +1,6 @@
 #include "Buffer.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 void Buffer::Reserve(std::size_t bms) {
@@ -15,42 +16,37 @@ std::size_t Buffer::GetFreeSlots() const {
 bool Buffer::Full() const { return buffer.size() == max_buffer_size; }
 bool Buffer::Empty() const { return buffer.size() == 0; }
 
-void Buffer::Clear() { buffer = std::queue<Flit>(); }
+void Buffer::Clear() { buffer.clear(); }
 void Buffer::Push(const Flit& flit) {
   if (Full())
     assert(false);
   else
-    buffer.push(flit);
+    buffer.push_back(flit);
 }
 Flit Buffer::Pop() {
   Flit f = buffer.front();
-  buffer.pop();
+  buffer.pop_front();
   return f;
 }
 Flit Buffer::Front() const { return buffer.front(); }
 std::int32_t Buffer::Size() const {
   return static_cast<std::int32_t>(buffer.size());
 }
+std::size_t Buffer::Deliveries() const {
+  std::size_t result = 0;
+  for (const Flit& flit : buffer) result += flit.Deliveries();
+  return result;
+}
 
 double Buffer::GetOldest() const {
-  auto copy = buffer;
-  double result = copy.front().timestamp;
-  copy.pop();
-  while (!copy.empty()) {
-    if (copy.front().timestamp < result) result = copy.front().timestamp;
-    copy.pop();
-  }
+  double result = buffer.front().timestamp;
+  for (const Flit& flit : buffer) result = std::min(result, flit.timestamp);
   return result;
 }
 double Buffer::GetOldestAccepted() const {
-  auto copy = buffer;
-  double result = copy.front().accept_timestamp;
-  copy.pop();
-  while (!copy.empty()) {
-    if (copy.front().accept_timestamp < result)
-      result = copy.front().accept_timestamp;
-    copy.pop();
-  }
+  double result = buffer.front().accept_timestamp;
+  for (const Flit& flit : buffer)
+    result = std::min(result, flit.accept_timestamp);
   return result;
 }
 double Buffer::GetLoad() const {
@@ -58,20 +54,10 @@ double Buffer::GetLoad() const {
 }
 
 std::ostream& operator<<(std::ostream& os, const Buffer& b) {
-  std::queue<Flit> m = b.buffer;
-
   os << '[';
-  while (m.size() > 1) {
-    Flit f = m.front();
-    m.pop();
-
-    if (HasFlag(f.flit_type, FlitType::Head)) os << 'H';
-    if (HasFlag(f.flit_type, FlitType::Body)) os << 'B';
-    if (HasFlag(f.flit_type, FlitType::Tail)) os << 'T';
-    os << f.sequence_no << '(' << f.src_id << "->" << f.dst_id << ") | ";
-  }
-  if (!m.empty()) {
-    Flit f = m.front();
+  for (std::size_t i = 0; i < b.buffer.size(); i++) {
+    const Flit& f = b.buffer[i];
+    if (i) os << " | ";
     if (HasFlag(f.flit_type, FlitType::Head)) os << 'H';
     if (HasFlag(f.flit_type, FlitType::Body)) os << 'B';
     if (HasFlag(f.flit_type, FlitType::Tail)) os << 'T';
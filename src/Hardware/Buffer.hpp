@@ -1,12 +1,12 @@
 #pragma once
-#include <queue>
+#include <deque>
 
 #include "Data/Flit.hpp"
 
 class Buffer {
  private:
-  std::size_t max_buffer_size;
-  std::queue<Flit> buffer;
+  std::size_t max_buffer_size = 0;
+  std::deque<Flit> buffer;
 
  public:
   void Reserve(std::size_t bms);
@@ -21,6 +21,8 @@ class Buffer {
   Flit Pop();
   Flit Front() const;
   std::int32_t Size() const;
+  // Destinations to be reached by buffered flits, see Flit::Deliveries
+  std::size_t Deliveries() const;
 
   double GetOldest() const;
   double GetOldestAccepted() const;
@@ -14,13 +14,31 @@ void Network::InitBase() {
   srand(Config.RndGeneratorSeed());
   Factory factory(Config);
 
-  if (Config.ReportFlitTrace()) {
+  if (Config.ReportFlitTrace() && !Config.FlitTraceFilename().empty()) {
+    Tracer = std::make_unique<FlitTracer>(
+        Timer, Config.FlitTraceStart(), Config.FlitTraceEnd(),
+        Config.FlitTraceFilename(), Tiles.size(), Config.FlitTraceSampling(),
+        Config.FlitTraceSources(), Config.FlitTraceDestinations());
+  } else if (Config.ReportFlitTrace()) {
     Tracer = std::make_unique<FlitTracer>(Timer, Config.FlitTraceStart(),
                                           Config.FlitTraceEnd());
   }
+  if (Config.ReportLatencyBreakdown()) SourceDelays.resize(Tiles.size());
+  if (!Config.FlowMatrixFilename().empty())
+    Flows = std::make_unique<FlowMatrix>(Tiles.size());
   Algorithm = factory.MakeAlgorithm();
   Strategy = factory.MakeStrategy();
   Traffic = factory.MakeTraffic();
+  if (Config.ClosedLoop() && (Traffic->Batched() || Traffic->Multicast()))
+    throw std::runtime_error(
+        "Configuration error: closed_loop is not supported by traffic "
+        "distribution [" +
+        Config.TrafficDistribution() + "].");
+
+  if (Traffic->Multicast() && Config.BufferDepth() < Config.MaxPacketSize())
+    throw std::runtime_error(
+        "Configuration error: buffer_depth can not be less than "
+        "max_packet_size for multicast traffic.");
 
   auto& graph = Config.NetworkGraph();
 
@@ -34,7 +52,12 @@ void Network::InitBase() {
       for (std::size_t vc = 0; vc < relay.Size(); vc++) {
         relay[vc].Reserve(Config.BufferDepth());
       }
+      if (Config.FlowControl() == "CREDIT")
+        relay.SetCreditFlowControl(Timer, Config.LinkLatency(),
+                                   Config.CreditDelay());
     }
+    RouterDevice->stats.SetLinks(RouterDevice->Size(),
+                                 Config.VirtualChannels());
 
     RouterDevice->SetRoutingAlgorithm(*Algorithm);
     RouterDevice->SetSelectionStrategy(*Strategy);
@@ -42,13 +65,29 @@ void Network::InitBase() {
       RouterDevice->SetFlitTracer(*Tracer);
     }
     RouterDevice->SetUpdateSequence(Config.UpdateSequence());
+    RouterDevice->SetPipeline(Config.RouterPipeline(),
+                              Config.LookaheadRouting(),
+                              Config.SpeculativeAllocation());
 
     std::unique_ptr<Processor> ProcessorDevice =
         GetProcessor(Timer, id, Config);
     ProcessorDevice->SetTrafficManager(*Traffic);
     if (Tracer) ProcessorDevice->SetFlitTracer(*Tracer);
+    if (!SourceDelays.empty())
+      ProcessorDevice->SetSourceHistograms(SourceDelays);
+    if (Flows) ProcessorDevice->SetFlowMatrix(*Flows);
+    ProcessorDevice->SetQueueCapacity(Config.SourceQueueCapacity(),
+                                      Config.SourceQueuePolicy() == "DROP");
+    if (Config.ClosedLoop()) {
+      ProcessorDevice->SetClosedLoop(Config.MaxOutstandingRequests(),
+                                     Config.ReplyServiceTime(),
+                                     Config.ReplyPacketSize());
+    }
     ProcessorDevice->relay.SetVirtualChannels(Config.VirtualChannels());
     ProcessorDevice->relay[0].Reserve(Config.BufferDepth());
+    if (Config.FlowControl() == "CREDIT")
+      ProcessorDevice->relay.SetCreditFlowControl(Timer, Config.LinkLatency(),
+                                                  Config.CreditDelay());
 
     auto& tile = Tiles[id];
     tile.SetRouter(RouterDevice);
@@ -6,6 +6,8 @@
 #include "Configuration/RoutingTable.hpp"
 #include "Configuration/TrafficManagers/TrafficManager.hpp"
 #include "Metrics/FlitTracer.hpp"
+#include "Metrics/FlowMatrix.hpp"
+#include "Metrics/LatencyHistogram.hpp"
 #include "Routing/RoutingAlgorithm.hpp"
 #include "Selection/SelectionStrategy.hpp"
 #include "Tile.hpp"
@@ -21,6 +23,8 @@ class Network : sc_module {
 
  public:
   std::unique_ptr<FlitTracer> Tracer;
+  std::vector<LatencyHistogram> SourceDelays;  // Delay breakdown by source
+  std::unique_ptr<FlowMatrix> Flows;
   const SimulationTimer Timer;
   sc_clock clock;
   sc_signal<bool> reset;
@@ -31,5 +35,9 @@ class Network : sc_module {
           sc_module_name = "NoC");
   ~Network();
 
+  const RoutingAlgorithm& GetRoutingAlgorithm() const { return *Algorithm; }
+  const SelectionStrategy& GetSelectionStrategy() const { return *Strategy; }
+  const TrafficManager& GetTrafficManager() const { return *Traffic; }
+
   friend std::ostream& operator<<(std::ostream& os, const Network& network);
 };
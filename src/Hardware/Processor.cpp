@@ -4,6 +4,8 @@
 #include <sstream>
 #include <string>
 
+#include "Metrics/Profiler.hpp"
+
 static std::string GetProcessorName(std::size_t id) {
   return (std::stringstream()
           << "Processor[" << std::setfill('0') << std::setw(3) << id << "]")
@@ -13,11 +15,15 @@ static std::size_t randInt(std::size_t min, std::size_t max) {
   return min + rand() / (RAND_MAX + 1.0) * (max - min + 1);
 }
 
-Packet& Processor::GetQueueFront() {
-  if (Queue.UpdateRequired())
-    Queue.UpdateFrontPacket(local_id, Traffic->FindDestination(local_id),
-                            randInt(MinPacketSize, MaxPacketSize));
-  return Queue.Front();
+bool Processor::Enqueue(Packet packet) {
+  if (Queue.Full()) {
+    if (DropPackets && Timer.StatisticsTime() >= 0) TotalPacketsDropped++;
+    return DropPackets;
+  }
+  if (packet.size <= 0) packet.size = randInt(MinPacketSize, MaxPacketSize);
+  packet.flit_left = packet.size;
+  Queue.Push(packet);
+  return true;
 }
 
 void Processor::ReceiveFlit(Flit flit) {
@@ -27,16 +33,40 @@ void Processor::ReceiveFlit(Flit flit) {
         std::to_string(local_id) + "] DestinationID[" +
         std::to_string(flit.dst_id) + "]");
 
+  if (HasFlag(flit.flit_type, FlitType::Head)) {
+    if (flit.vc_id >= HeadArrivals.size()) HeadArrivals.resize(flit.vc_id + 1);
+    HeadArrivals[flit.vc_id] = {Timer.SystemTime(), flit.router_wait};
+  }
+
   if (Timer.StatisticsTime() >= 0) {
     if (HasFlag(flit.flit_type, FlitType::Tail)) {
       double delay = Timer.SystemTime() - flit.timestamp;
       TotalPacketsDelay += delay;
       if (delay > MaxPacketDelay) MaxPacketDelay = delay;
+      DelayHistogram.Record(delay);
+      if (SourceHistograms) (*SourceHistograms)[flit.src_id].Record(delay);
+      // Hops are counted by relays of both processors too
+      if (Flows)
+        Flows->Receive(flit.src_id, local_id, flit.sequence_length,
+                       flit.hop_no - 2, delay);
+      TotalQueueDelay += flit.inject_timestamp - flit.timestamp;
+      auto [head_time, router_wait] = HeadArrivals[flit.vc_id];
+      TotalRouterWait += router_wait;
+      TotalTraversalDelay += head_time - flit.inject_timestamp - router_wait;
+      TotalSerializationDelay += Timer.SystemTime() - head_time;
 
       TotalPacketsReceived++;
     }
     TotalFlitsReceived++;
 
+    if (ClosedLoop && flit.request_timestamp >= 0 &&
+        HasFlag(flit.flit_type, FlitType::Tail)) {
+      double round_trip = Timer.SystemTime() - flit.request_timestamp;
+      TotalRoundTripDelay += round_trip;
+      if (round_trip > MaxRoundTripDelay) MaxRoundTripDelay = round_trip;
+      TotalTransactions++;
+    }
+
     if (Timer.StatisticsTime() - flit.accept_timestamp >
         SimulationMaxTimeFlitInNetwork)
       SimulationMaxTimeFlitInNetwork =
@@ -44,24 +74,59 @@ void Processor::ReceiveFlit(Flit flit) {
     SimulationLastTimeFlitReceived = Timer.StatisticsTime();
   }
   TotalActualFlitsReceived++;
+  if (Tracer) Tracer->Eject(flit, local_id);
+  if (HasFlag(flit.flit_type, FlitType::Tail)) TotalActualPacketsReceived++;
+
+  if (flit.message_id >= 0 && HasFlag(flit.flit_type, FlitType::Tail))
+    Traffic->PacketReceived(local_id, flit.message_id, Timer.SystemTime());
+
+  if (ClosedLoop && HasFlag(flit.flit_type, FlitType::Tail)) {
+    if (flit.request_timestamp >= 0) {
+      Outstanding--;
+    } else {
+      Packet reply(local_id, flit.src_id, 0, Timer.SystemTime() + ServiceTime,
+                   ReplySize);
+      reply.request_timestamp = flit.timestamp;
+      Replies.push_back(reply);
+    }
+  }
 }
 void Processor::SendFlit(Flit flit) {
-  if (Timer.StatisticsTime() >= 0) TotalFlitsSent++;
+  if (Timer.StatisticsTime() >= 0) {
+    TotalFlitsSent++;
+    if (Flows && HasFlag(flit.flit_type, FlitType::Head)) {
+      if (!flit.multicast) {
+        Flows->Inject(flit.src_id, flit.dst_id);
+      } else {
+        for (std::int32_t dst : *flit.multicast)
+          Flows->Inject(flit.src_id, dst);
+      }
+    }
+  }
   TotalActualFlitsSent++;
+  TotalActualDeliveriesSent += flit.Deliveries();
+  if (HasFlag(flit.flit_type, FlitType::Head))
+    TotalActualPacketsSent += flit.Deliveries();
 }
 
 Flit Processor::NextFlit() {
-  Packet& packet = GetQueueFront();
+  const Packet& packet = Queue.Front();
 
   Flit flit;
   flit.src_id = packet.src_id;
   flit.dst_id = packet.dst_id;
   flit.vc_id = packet.vc_id;
   flit.timestamp = packet.timestamp;
+  flit.inject_timestamp = packet.size == packet.flit_left
+                              ? Timer.SystemTime()
+                              : packet.inject_timestamp;
   flit.accept_timestamp = Timer.StatisticsTime();
   flit.sequence_no = packet.size - packet.flit_left;
   flit.sequence_length = packet.size;
   flit.hop_no = 0;
+  flit.request_timestamp = packet.request_timestamp;
+  flit.message_id = packet.message_id;
+  flit.multicast = packet.multicast;
 
   if (packet.size == packet.flit_left)
     flit.flit_type = flit.flit_type | FlitType::Head;
@@ -72,9 +137,10 @@ Flit Processor::NextFlit() {
   return flit;
 }
 void Processor::PopFlit() {
-  Packet& packet = GetQueueFront();
-  packet.flit_left--;
-  if (packet.flit_left == 0) Queue.Pop();
+  Packet& packet = Queue.Front();
+  if (packet.size == packet.flit_left)
+    packet.inject_timestamp = Timer.SystemTime();
+  Queue.PopFlit();
 }
 
 Processor::Processor(sc_module_name, const SimulationTimer& timer,
@@ -84,7 +150,8 @@ Processor::Processor(sc_module_name, const SimulationTimer& timer,
       local_id(id),
       MinPacketSize(min_packet_size),
       MaxPacketSize(max_packet_size),
-      Traffic(nullptr) {
+      Traffic(nullptr),
+      NextInjectionTime(-1) {
   SC_METHOD(Update);
   sensitive << reset << clock.pos();
 }
@@ -97,8 +164,25 @@ void Processor::SetTrafficManager(const TrafficManager& traffic) {
   Traffic = &traffic;
 }
 void Processor::SetFlitTracer(FlitTracer& tracer) { Tracer = &tracer; }
+void Processor::SetClosedLoop(std::int32_t max_outstanding,
+                              double service_time, std::int32_t reply_size) {
+  ClosedLoop = true;
+  MaxOutstanding = max_outstanding;
+  ServiceTime = service_time;
+  ReplySize = reply_size;
+}
+void Processor::SetQueueCapacity(std::size_t capacity, bool drop) {
+  Queue.SetCapacity(capacity);
+  DropPackets = drop;
+}
+void Processor::SetSourceHistograms(
+    std::vector<LatencyHistogram>& histograms) {
+  SourceHistograms = &histograms;
+}
+void Processor::SetFlowMatrix(FlowMatrix& flows) { Flows = &flows; }
 
 void Processor::Update() {
+  PROFILE_SCOPE(ProcessorUpdate);
   if (reset.read()) {
     relay.Reset();
 
@@ -107,18 +191,84 @@ void Processor::Update() {
     TotalFlitsReceived = 0;
     TotalActualFlitsSent = 0;
     TotalActualFlitsReceived = 0;
+    TotalActualPacketsSent = 0;
+    TotalActualDeliveriesSent = 0;
+    TotalActualPacketsReceived = 0;
 
     TotalPacketsDelay = 0;
+    TotalQueueDelay = 0;
+    TotalRouterWait = 0;
+    TotalTraversalDelay = 0;
+    TotalSerializationDelay = 0;
+    HeadArrivals.clear();
     MaxPacketDelay = 0;
+    DelayHistogram.Reset();
+    TotalPacketsDropped = 0;
     SimulationMaxTimeFlitInNetwork = 0;
     SimulationLastTimeFlitReceived = 0;
+    NextInjectionTime = -1;
+
+    TotalTransactions = 0;
+    TotalRoundTripDelay = 0;
+    MaxRoundTripDelay = 0;
+    Outstanding = 0;
+    Replies.clear();
   } else {
-    if (Timer.SimulationTime() < Timer.ProductionTime()) {
-      if (Traffic->FirePacket(local_id, Timer.SystemTime())) {
-        Queue.Push(Timer.SystemTime());
+    // Injection cycles are sampled ahead, so there is no traffic work
+    // on cycles without injection
+    double time = Timer.SystemTime();
+    double production_end =
+        time - Timer.SimulationTime() + Timer.ProductionTime();
+    {
+      PROFILE_SCOPE(TrafficGeneration);
+      if (Traffic->Batched()) {
+        // Packets which do not fit the queue wait in batch
+        if (time < production_end || Traffic->Closed())
+          Traffic->PacketsAt(local_id, time, Batch);
+        auto packet = Batch.begin();
+        while (packet != Batch.end() && Enqueue(*packet)) packet++;
+        Batch.erase(Batch.begin(), packet);
+      } else {
+        if (NextInjectionTime < 0) {
+          NextInjectionTime =
+              Traffic->NextPacketTime(local_id, time - 1, production_end);
+        }
+        // Packet waits for free outstanding slot in closed loop mode and for
+        // free queue slot with back pressure
+        if (time >= NextInjectionTime && time < production_end &&
+            (!ClosedLoop || Outstanding < MaxOutstanding) &&
+            (DropPackets || !Queue.Full())) {
+          if (!Queue.Full() && ClosedLoop) Outstanding++;
+          // Multicast delivery is tracked only for packets which are not
+          // dropped
+          // Blocked packet is created late, but its delay counts from the
+          // cycle it was generated
+          Packet packet(local_id, -1, 0, NextInjectionTime, 0);
+          if (!Traffic->Multicast()) {
+            packet.dst_id = Traffic->FindDestination(local_id);
+          } else if (!Queue.Full()) {
+            packet.message_id =
+                Traffic->FindDestinations(local_id, time, packet.multicast);
+            packet.dst_id = packet.multicast->front();
+          }
+          Enqueue(packet);
+          NextInjectionTime =
+              Traffic->NextPacketTime(local_id, time, production_end);
+        }
       }
     }
 
+    // Service time is the same for all requests, so replies are ready in
+    // order of arrival
+    // Replies are bounded by outstanding requests and ignore capacity
+    while (!Replies.empty() && Replies.front().timestamp <= time) {
+      Packet& reply = Replies.front();
+      if (reply.size <= 0) reply.size = randInt(MinPacketSize, MaxPacketSize);
+      reply.flit_left = reply.size;
+      Queue.Push(reply);
+      Replies.pop_front();
+    }
+
     TXProcess();
     RXProcess();
   }
@@ -135,7 +285,7 @@ void Processor::TXProcess() {
   }
 }
 void Processor::RXProcess() {
-  relay.Receive();
+  relay.Receive(Timer.SystemTime());
   Flit flit = relay.Pop();
   if (flit.valid()) {
     ReceiveFlit(flit);
@@ -146,21 +296,56 @@ void Processor::RXProcess() {
 std::size_t Processor::FlitsSent() const { return TotalFlitsSent; }
 std::size_t Processor::FlitsReceived() const { return TotalFlitsReceived; }
 std::size_t Processor::FlitsProduced() const {
-  return TotalFlitsSent + Queue.Size() * (MaxPacketSize + MinPacketSize) / 2;
+  return TotalFlitsSent + Queue.Flits();
 }
 std::size_t Processor::ActualFlitsSent() const { return TotalActualFlitsSent; }
 std::size_t Processor::ActualFlitsReceived() const {
   return TotalActualFlitsReceived;
 }
+std::size_t Processor::ActualFlitsProduced() const {
+  return TotalActualFlitsSent + Queue.Flits();
+}
+std::size_t Processor::ActualPacketsSent() const {
+  return TotalActualPacketsSent;
+}
+std::size_t Processor::ActualDeliveriesSent() const {
+  return TotalActualDeliveriesSent;
+}
+std::size_t Processor::ActualPacketsReceived() const {
+  return TotalActualPacketsReceived;
+}
 
 std::size_t Processor::PacketsReceived() const { return TotalPacketsReceived; }
 double Processor::AverageDelay() const {
   return TotalPacketsDelay / TotalPacketsReceived;
 }
+double Processor::AverageQueueDelay() const {
+  return TotalQueueDelay / TotalPacketsReceived;
+}
+double Processor::AverageNetworkDelay() const {
+  return (TotalPacketsDelay - TotalQueueDelay) / TotalPacketsReceived;
+}
+double Processor::AverageRouterWait() const {
+  return TotalRouterWait / TotalPacketsReceived;
+}
+double Processor::AverageTraversalDelay() const {
+  return TotalTraversalDelay / TotalPacketsReceived;
+}
+double Processor::AverageSerializationDelay() const {
+  return TotalSerializationDelay / TotalPacketsReceived;
+}
 double Processor::MaxDelay() const { return MaxPacketDelay; }
+const LatencyHistogram& Processor::Delays() const { return DelayHistogram; }
+std::size_t Processor::PacketsDropped() const { return TotalPacketsDropped; }
 double Processor::MaxTimeFlitInNetwork() const {
   return SimulationMaxTimeFlitInNetwork;
 }
 double Processor::LastReceivedFlitTime() const {
   return SimulationLastTimeFlitReceived;
 }
+
+std::size_t Processor::Transactions() const { return TotalTransactions; }
+double Processor::AverageRoundTripDelay() const {
+  return TotalRoundTripDelay / TotalTransactions;
+}
+double Processor::MaxRoundTrip() const { return MaxRoundTripDelay; }
@@ -2,10 +2,15 @@
 #include <systemc.h>
 
 #include <cstdint>
+#include <deque>
 #include <queue>
+#include <utility>
+#include <vector>
 
 #include "Configuration/TrafficManagers/TrafficManager.hpp"
 #include "Metrics/FlitTracer.hpp"
+#include "Metrics/FlowMatrix.hpp"
+#include "Metrics/LatencyHistogram.hpp"
 #include "ProcessorQueue.hpp"
 #include "Relay.hpp"
 #include "SimulationTimer.hpp"
@@ -18,7 +23,20 @@ class Processor : public sc_module {
   std::int32_t MaxID;
   const TrafficManager* Traffic;
   ProcessorQueue Queue;
-  Packet& GetQueueFront();
+  double NextInjectionTime;   // Cycle of the next packet injection
+  std::vector<Packet> Batch;  // Packets of batched traffic manager
+
+  // Closed loop mode: each request gets reply from destination after service
+  // time, requests are issued only while there are free outstanding slots
+  bool ClosedLoop = false;
+  std::int32_t MaxOutstanding;
+  double ServiceTime;
+  std::int32_t ReplySize;
+  std::int32_t Outstanding;
+  std::deque<Packet> Replies;  // Replies waiting for service completion
+  bool DropPackets = false;  // Policy of bounded queue, back pressure if not
+  // Returns false if packet must wait for free queue slot
+  bool Enqueue(Packet packet);
 
   const std::size_t MinPacketSize;
   const std::size_t MaxPacketSize;
@@ -28,12 +46,33 @@ class Processor : public sc_module {
   std::size_t TotalFlitsReceived;
   std::size_t TotalActualFlitsSent;
   std::size_t TotalActualFlitsReceived;
+  std::size_t TotalActualPacketsSent;  // Counted for each destination
+  std::size_t TotalActualDeliveriesSent;  // Flits counted for each destination
+  std::size_t TotalActualPacketsReceived;
 
   double TotalPacketsDelay;
+  double TotalQueueDelay;  // Part of the delay before injection
+  // Network delay of packet split into queueing of its head in routers,
+  // head traversal and arrival of other flits after the head
+  double TotalRouterWait;
+  double TotalTraversalDelay;
+  double TotalSerializationDelay;
+  // Arrival time and router wait of the last head by virtual channel, packets
+  // do not interleave within virtual channel
+  std::vector<std::pair<double, double>> HeadArrivals;
+  std::size_t TotalPacketsDropped;
   double MaxPacketDelay;
+  LatencyHistogram DelayHistogram;
+  // Histograms by source node shared by all processors, optional
+  std::vector<LatencyHistogram>* SourceHistograms = nullptr;
+  FlowMatrix* Flows = nullptr;  // Shared by all processors, optional
   double SimulationMaxTimeFlitInNetwork;
   double SimulationLastTimeFlitReceived;
 
+  std::size_t TotalTransactions;
+  double TotalRoundTripDelay;
+  double MaxRoundTripDelay;
+
   FlitTracer* Tracer = nullptr;
 
   void ReceiveFlit(Flit flit);
@@ -59,6 +98,11 @@ class Processor : public sc_module {
             std::int32_t min_packet_size, std::int32_t max_packet_size);
   void SetTrafficManager(const TrafficManager& traffic);
   void SetFlitTracer(FlitTracer& tracer);
+  void SetClosedLoop(std::int32_t max_outstanding, double service_time,
+                     std::int32_t reply_size);
+  void SetQueueCapacity(std::size_t capacity, bool drop);
+  void SetSourceHistograms(std::vector<LatencyHistogram>& histograms);
+  void SetFlowMatrix(FlowMatrix& flows);
 
   // Functions
   void Update();
@@ -70,10 +114,25 @@ class Processor : public sc_module {
   std::size_t FlitsProduced() const;
   std::size_t ActualFlitsSent() const;
   std::size_t ActualFlitsReceived() const;
+  std::size_t ActualFlitsProduced() const;
+  std::size_t ActualPacketsSent() const;
+  std::size_t ActualDeliveriesSent() const;
+  std::size_t ActualPacketsReceived() const;
 
   std::size_t PacketsReceived() const;
   double AverageDelay() const;
+  double AverageQueueDelay() const;
+  double AverageNetworkDelay() const;
+  double AverageRouterWait() const;
+  double AverageTraversalDelay() const;
+  double AverageSerializationDelay() const;
   double MaxDelay() const;
+  const LatencyHistogram& Delays() const;
+  std::size_t PacketsDropped() const;
   double MaxTimeFlitInNetwork() const;
   double LastReceivedFlitTime() const;
+
+  std::size_t Transactions() const;
+  double AverageRoundTripDelay() const;
+  double MaxRoundTrip() const;
 };
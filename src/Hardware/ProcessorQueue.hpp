@@ -1,24 +1,33 @@
 #pragma once
+#include <vector>
+
 #include "Data/Packet.hpp"
 
+// Exact FIFO queue of packets waiting for injection. Packets are kept in
+// ring buffer which grows by doubling and never shrinks, so storage is
+// reused once the queue reaches its working size.
 class ProcessorQueue {
  private:
-  std::size_t packets_in_queue;
-  double oldest_packet_time_stamp;
-  double newest_packet_time_stamp;
-  Packet current_packet;
-  bool update_required;
+  std::vector<Packet> storage;
+  std::size_t head;
+  std::size_t count;
+  std::size_t flits;     // Flits left in all queued packets
+  std::size_t capacity;  // Number of packets, 0 if unbounded
 
  public:
   ProcessorQueue();
 
-  bool UpdateRequired() const;
-  void UpdateFrontPacket(std::int32_t src_id, std::int32_t dst_id,
-                         std::int32_t size);
+  void SetCapacity(std::size_t capacity);
+  bool Full() const;
 
-  void Push(double time_stamp);
+  // Push ignores capacity, Full must be checked by the caller
+  void Push(const Packet& packet);
   void Pop();
   Packet& Front();
+  // Removes one flit of the front packet and pops it after the last one
+  void PopFlit();
+
   bool Empty() const;
   std::size_t Size() const;
-};
\ No newline at end of file
+  std::size_t Flits() const;
+};
@@ -65,7 +65,31 @@ void Relay::Disable() {
     tx_free_slots[i].write(-1);
 }
 
+void Relay::SetCreditFlowControl(const SimulationTimer& timer,
+                                 std::int32_t link_latency,
+                                 std::int32_t credit_delay) {
+  this->timer = &timer;
+  this->link_latency = link_latency;
+  this->credit_delay = credit_delay;
+}
+void Relay::CollectCredits() const {
+  double now = timer->SystemTime();
+  while (!returned.empty() && returned.front().first <= now) {
+    credits[returned.front().second]++;
+    returned.pop_front();
+  }
+}
+
 void Relay::Reset() {
+  if (timer) {
+    link.clear();
+    returned.clear();
+    last_send_time = -1;
+    credits.assign(bound->num_virtual_channels, 0);
+    for (std::size_t i = 0; i < credits.size(); i++)
+      credits[i] = bound->buffers[i].GetCapacity();
+  }
+
   // Clear out
   tx_req.write(0);
   tx_current_level = false;
@@ -79,32 +103,58 @@ void Relay::Reset() {
   }
 }
 void Relay::Update() {
+  if (timer) return;
   for (std::size_t i = 0; i < num_virtual_channels; i++)
     tx_free_slots[i].write(buffers[i].GetFreeSlots());
 }
-bool Relay::CanSend(const Flit& flit) const {
-  return tx_current_level == tx_ack.read() &&
-         rx_free_slots[flit.vc_id].read() > 0;
-}
+bool Relay::CanSend(const Flit& flit) const { return CanSend(flit.vc_id); }
 bool Relay::CanSend(std::size_t vc) const {
+  // Link takes one flit per cycle
+  if (timer)
+    return last_send_time < timer->SystemTime() && GetFreeSlots(vc) > 0;
   return tx_current_level == tx_ack.read() && rx_free_slots[vc].read() > 0;
 }
 bool Relay::Send(Flit flit) {
-  if (CanSend(flit)) {
-    flit.port_out = local_id;
+  if (!CanSend(flit)) return false;
+
+  flit.port_out = local_id;
+  if (timer) {
+    last_send_time = timer->SystemTime();
+    credits[flit.vc_id]--;
+    bound->link.emplace_back(last_send_time + link_latency, flit);
+  } else {
     tx_flit.write(flit);
     tx_current_level = !tx_current_level;
     tx_req.write(tx_current_level);
-
-    return true;
-  } else
-    return false;
+  }
+  return true;
+}
+bool Relay::CanReceive() const {
+  if (timer)
+    return !link.empty() && link.front().first <= timer->SystemTime();
+  return rx_req.read() == !rx_current_level;
+}
+std::size_t Relay::InTransit() const {
+  if (timer) return link.size();
+  return CanReceive();
+}
+std::size_t Relay::InTransitDeliveries() const {
+  if (!timer) return CanReceive() ? rx_flit.read().Deliveries() : 0;
+  std::size_t result = 0;
+  for (const auto& [time, flit] : link) result += flit.Deliveries();
+  return result;
 }
-bool Relay::CanReceive() const { return rx_req.read() == !rx_current_level; }
-Flit Relay::Receive() {
+Flit Relay::Receive(double time) {
   if (CanReceive()) {
-    Flit flit = rx_flit.read();
+    Flit flit;
+    if (timer) {
+      flit = link.front().second;
+      link.pop_front();
+    } else {
+      flit = rx_flit.read();
+    }
     flit.hop_no++;
+    flit.hop_timestamp = time;
     flit.port_in = local_id;
 
     if (flit.vc_id < 0 || flit.vc_id >= num_virtual_channels)
@@ -118,6 +168,7 @@ Flit Relay::Receive() {
       throw std::runtime_error("Relay error: Buffer overflow.");
 
     buffer.Push(flit);
+    if (timer) return flit;
 
     rx_current_level = !rx_current_level;
     rx_ack.write(rx_current_level);
@@ -154,6 +205,8 @@ Flit Relay::Pop() {
   std::size_t vc = (vc_offset + i) % num_virtual_channels;
 
   if (i < num_virtual_channels) {
+    if (timer)
+      bound->returned.emplace_back(timer->SystemTime() + credit_delay, vc);
     return buffers[vc].Pop();
   } else {
     return Flit();
@@ -1,6 +1,11 @@
 #pragma once
+#include <deque>
+#include <utility>
+#include <vector>
+
 #include "Buffer.hpp"
 #include "Data/Flit.hpp"
+#include "SimulationTimer.hpp"
 
 class Relay {
  private:
@@ -33,6 +38,20 @@ class Relay {
   Buffer* buffers = nullptr;  // buffers[virtual_channel]
   Relay* bound = nullptr;
 
+  // Credit based flow control, set when timer is not null. Flits and
+  // credits are handed to the bound relay directly with arrival time at
+  // least one cycle ahead, so the result does not depend on the order of
+  // module updates within a cycle.
+  const SimulationTimer* timer = nullptr;
+  std::int32_t link_latency = 1;
+  std::int32_t credit_delay = 1;
+  double last_send_time = -1;
+  std::deque<std::pair<double, Flit>> link;  // Incoming flits by arrival
+  // Credits of outgoing virtual channels by arrival, collected on first use
+  mutable std::deque<std::pair<double, std::size_t>> returned;
+  mutable std::vector<std::size_t> credits;  // Free slots of bound relay
+  void CollectCredits() const;
+
  public:
   Relay();
   ~Relay();
@@ -43,6 +62,12 @@ class Relay {
   void Bind(Relay& r);
   bool Bound() const { return bound; }
   void Disable();
+  // Replaces alternating bit protocol with credit based flow control, flit
+  // sent in one cycle is received link_latency cycles later, slot freed in
+  // the next buffer is known to sender credit_delay cycles later
+  void SetCreditFlowControl(const SimulationTimer& timer,
+                            std::int32_t link_latency,
+                            std::int32_t credit_delay);
 
   void Reset();
   void Update();
@@ -50,15 +75,24 @@ class Relay {
   bool CanSend(std::size_t vc) const;
   bool Send(Flit flit);
   bool CanReceive() const;
-  Flit Receive();
+  // Received flit is stamped with arrival time
+  Flit Receive(double time);
 
   // WARNING: Can return irrelevant value due to load changes during cycle
   // You must check CanSend function before using it.
   std::size_t GetFreeSlots(std::size_t vc) const {
     // if (rx_free_slots[vc].read() > bound->buffers[vc].GetFreeSlots())
     //	throw "shit";
+    if (timer) {
+      CollectCredits();
+      return credits[vc];
+    }
     return rx_free_slots[vc].read();  // * CanSend(vc) ???
   }
+  // Flits sent to this relay and not received yet
+  std::size_t InTransit() const;
+  // Destinations to be reached by flits in transit, see Flit::Deliveries
+  std::size_t InTransitDeliveries() const;
 
   Flit Front() const;
   void Skip();
@@ -13,6 +13,10 @@ void ReservationTable::Reserve(Connection dest_in, Connection dest_out) {
   }
   Table.push_back({dest_in, dest_out});
 }
+void ReservationTable::ReserveBranch(Connection dest_in,
+                                     Connection dest_out) {
+  Table.push_back({dest_in, dest_out});
+}
 void ReservationTable::Release(Connection dest_in) {
   std::size_t s = 0;
   for (std::size_t i = 0; i < Table.size(); i++) {
@@ -44,6 +48,11 @@ Connection ReservationTable::operator[](Connection dest_in) const {
     if (node.in == dest_in) return node.out;
   return Connection();
 }
+Connection ReservationTable::Source(Connection dest_out) const {
+  for (const auto& node : Table)
+    if (node.out == dest_out) return node.in;
+  return Connection();
+}
 
 std::ostream& operator<<(std::ostream& os, const ReservationTable& table) {
   auto t = table.Table;
@@ -10,10 +10,13 @@ class ReservationTable {
 
  public:
   void Reserve(Connection dest_in, Connection dest_out);
+  // Adds one more output to the input, used for multicast replication
+  void ReserveBranch(Connection dest_in, Connection dest_out);
   void Release(Connection dest_in);
   bool Reserved(Connection dest_in, Connection dest_out) const;
   bool Reserved(Connection dest_out) const;
   Connection operator[](Connection dest_in) const;
+  Connection Source(Connection dest_out) const;
 
   friend std::ostream& operator<<(std::ostream& os,
                                   const ReservationTable& table);
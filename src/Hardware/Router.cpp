@@ -1,7 +1,9 @@
 #include "Router.hpp"
 
+#include <algorithm>
 #include <iomanip>
 
+#include "Metrics/Profiler.hpp"
 #include "Routing/RoutingAlgorithm.hpp"
 #include "Selection/SelectionStrategy.hpp"
 
@@ -31,20 +33,75 @@ Router::Router(sc_module_name, const SimulationTimer& timer, std::int32_t id,
 }
 
 void Router::Reservation(std::int32_t in_port) {
+  PROFILE_SCOPE(Reservation);
   Relay& rel = relays[in_port];
 
   Flit flit = rel.Front();
   if (flit.valid() && HasFlag(flit.flit_type, FlitType::Head)) {
+    // Route computation and VC allocation stages are not passed yet
+    if (stats.Timer.SystemTime() < flit.hop_timestamp + reservation_delay)
+      return;
     Connection src = {in_port, flit.vc_id};
+    if (flit.multicast) {
+      if (!branches.count(src)) MulticastReservation(src, flit);
+      return;
+    }
+    if (pipelined && reservation_table[src].valid()) return;
     Connection dst = FindDestination(flit);
     if (dst.valid() && !reservation_table.Reserved(src, dst)) {
       reservation_table.Reserve(src, dst);
+      Allocated(src);
+    } else if (dst.valid() && !reservation_table[src].valid()) {
+      stats.LinkBlocked(dst.port, dst.vc);
+    }
+  }
+}
+void Router::MulticastReservation(Connection src, const Flit& flit) {
+  // Destinations are split by output port chosen for each of them, so the
+  // packet is replicated along the tree of unicast routes. All outputs are
+  // reserved at once and only when the whole packet fits each next buffer,
+  // otherwise reservation is retried next cycle. So replicated packet never
+  // waits for one branch while holding others, which would deadlock
+  // wormhole switching.
+  std::map<std::int32_t, std::pair<Connection, std::vector<std::int32_t>>>
+      split;
+  Flit probe = flit;
+  probe.multicast = nullptr;
+  for (std::int32_t dst_id : *flit.multicast) {
+    probe.dst_id = dst_id;
+    Connection dst = FindDestination(probe);
+    if (!dst.valid()) return;
+    if (!CanSend(dst) || DestinationFreeSlots(dst) < flit.sequence_length) {
+      if (reservation_table.Reserved(dst))
+        stats.LinkBlocked(dst.port, dst.vc);
+      else
+        LinkStall(dst);
+      return;
     }
+    auto& branch = split[dst.port];
+    if (branch.second.empty()) branch.first = dst;
+    branch.second.push_back(dst_id);
   }
+
+  std::vector<Branch>& outs = branches[src];
+  for (auto& [port, branch] : split) {
+    auto& [dst, destinations] = branch;
+    reservation_table.ReserveBranch(src, dst);
+    if (destinations.size() == 1) {
+      outs.push_back({dst, destinations.front(), nullptr});
+    } else {
+      outs.push_back({dst, destinations.front(),
+                      std::make_shared<const std::vector<std::int32_t>>(
+                          std::move(destinations))});
+    }
+  }
+  Allocated(src);
 }
 void Router::Update() {
+  PROFILE_SCOPE(RouterUpdate);
   if (reset.read()) {
     for (auto& relay : relays) relay.Reset();
+    branches.clear();
 
     return;
   }
@@ -54,14 +111,18 @@ void Router::Update() {
 
   start_from_port = (start_from_port + 1) % relays.size();
 
-  for (int i = 0; i < relays.size(); i++) {
-    relays[i].Update();
-    for (int j = 0; j < relays[i].Size(); j++)
-      stats.PushLoad(i, j, relays[i][j].GetLoad());
+  for (auto& relay : relays) relay.Update();
+  {
+    PROFILE_SCOPE(StatsUpdate);
+    for (int i = 0; i < relays.size(); i++) {
+      for (int j = 0; j < relays[i].Size(); j++)
+        stats.PushLoad(i, j, relays[i][j].GetLoad());
+    }
   }
 }
 
 Connection Router::FindDestination(const Flit& flit) {
+  PROFILE_SCOPE(FindDestination);
   if (flit.dst_id == LocalId) return {LocalRelayId, 0};
 
   routing_buffer.clear();
@@ -69,18 +130,23 @@ Connection Router::FindDestination(const Flit& flit) {
   return selection->Apply(*this, flit, routing_buffer);
 }
 bool Router::Route(std::int32_t in_port, Connection dst) {
+  PROFILE_SCOPE(Route);
   Relay& in_relay = relays[in_port];
   Relay& out_relay = relays[dst.port];
 
   Flit flit = in_relay.Front();
   std::int32_t in_vc = flit.vc_id;
   flit.vc_id = dst.vc;
+  double wait = RouterWait(flit);
+  flit.router_wait += wait;
 
   if (out_relay.Send(flit)) {
     in_relay.Pop();
 
     // --------------- Stats --------------- //
     stats.FlitRouted(flit);
+    stats.FlitWaited(flit, wait);
+    stats.LinkTraversed(dst.port, dst.vc);
     stats.StopStuckTimer(in_port, in_vc);
     if (in_relay[flit.vc_id].Size()) {
       stats.StartStuckTimer(in_port, in_vc);
@@ -88,16 +154,83 @@ bool Router::Route(std::int32_t in_port, Connection dst) {
     // --------------- ----- --------------- //
 
     return true;
-  } else
+  } else {
+    LinkStall(dst);
     return false;
+  }
+}
+double Router::RouterWait(const Flit& flit) const {
+  // Flit received in one cycle is forwarded after pipeline stages at best
+  std::int32_t pipeline = HasFlag(flit.flit_type, FlitType::Head)
+                              ? reservation_delay + switch_delay
+                              : body_delay;
+  return stats.Timer.SystemTime() - flit.hop_timestamp - pipeline;
+}
+bool Router::PipelineReady(Connection src, const Flit& flit) const {
+  double now = stats.Timer.SystemTime();
+  if (!HasFlag(flit.flit_type, FlitType::Head))
+    return now >= flit.hop_timestamp + body_delay;
+  return !switch_delay ||
+         now >= allocation_time[src.port * vcs + src.vc] + switch_delay;
+}
+void Router::Allocated(Connection src) {
+  if (switch_delay)
+    allocation_time[src.port * vcs + src.vc] = stats.Timer.SystemTime();
+}
+void Router::LinkStall(Connection dst) {
+  // Output without free slots in the next buffer waits for credits,
+  // otherwise link is busy
+  if (relays[dst.port].GetFreeSlots(dst.vc) == 0)
+    stats.LinkCreditStall(dst.port, dst.vc);
+  else
+    stats.LinkBlocked(dst.port, dst.vc);
+}
+
+bool Router::MulticastRoute(std::int32_t in_port,
+                            const std::vector<Branch>& outs) {
+  PROFILE_SCOPE(Route);
+  // Flit leaves the input only when all branches can take it
+  bool ready = true;
+  for (const Branch& branch : outs) {
+    if (!relays[branch.out.port].CanSend(branch.out.vc)) {
+      LinkStall(branch.out);
+      ready = false;
+    }
+  }
+  if (!ready) return false;
+
+  Relay& in_relay = relays[in_port];
+  Flit flit = in_relay.Pop();
+  double wait = RouterWait(flit);
+  flit.router_wait += wait;
+  stats.FlitWaited(flit, wait);
+  for (const Branch& branch : outs) {
+    Flit copy = flit;
+    copy.vc_id = branch.out.vc;
+    copy.dst_id = branch.dst_id;
+    copy.multicast = branch.multicast;
+    relays[branch.out.port].Send(copy);
+    stats.FlitRouted(copy);
+    stats.LinkTraversed(branch.out.port, branch.out.vc);
+  }
+
+  // --------------- Stats --------------- //
+  stats.StopStuckTimer(in_port, flit.vc_id);
+  if (in_relay[flit.vc_id].Size()) {
+    stats.StartStuckTimer(in_port, flit.vc_id);
+  }
+  // --------------- ----- --------------- //
+
+  return true;
 }
 
 void Router::RXProcess() {
+  PROFILE_SCOPE(RXProcess);
   // This process simply sees a flow of incoming flits. All arbitration
   // and wormhole related issues are addressed in the txProcess()
   for (std::size_t i = 0; i < relays.size(); i++) {
     if (relays[i].CanReceive()) {
-      Flit flit = relays[i].Receive();
+      Flit flit = relays[i].Receive(stats.Timer.SystemTime());
 
       // --------------- Stats --------------- //
       stats.FlitReceived(i, flit.vc_id);
@@ -132,6 +265,16 @@ void Router::TXProcess() {
     Flit flit = relay.Front();
     if (flit.valid()) {
       Connection src = {in_port, flit.vc_id};
+      if (!PipelineReady(src, flit)) continue;
+      auto branch = branches.find(src);
+      if (branch != branches.end()) {
+        if (MulticastRoute(in_port, branch->second) &&
+            HasFlag(flit.flit_type, FlitType::Tail)) {
+          reservation_table.Release(src);
+          branches.erase(branch);
+        }
+        continue;
+      }
       Connection dst = reservation_table[src];
 
       if (!dst.valid()) {
@@ -161,6 +304,29 @@ void Router::SetFlitTracer(FlitTracer& tracer) { this->tracer = &tracer; }
 void Router::SetUpdateSequence(const std::vector<std::int32_t>& sequence) {
   update_sequence = sequence;
 }
+void Router::SetPipeline(const std::vector<std::int32_t>& stages,
+                         bool lookahead, bool speculative) {
+  std::int32_t route = lookahead ? 0 : stages[0];
+  std::int32_t vc_allocation = stages[1];
+  std::int32_t switch_allocation = stages[2];
+  std::int32_t traversal = stages[3];
+
+  // Stages start in the cycle after flit arrival, so nothing is forwarded
+  // earlier than in the next cycle
+  if (speculative) {
+    reservation_delay =
+        std::max(1, route + std::max(vc_allocation, switch_allocation));
+    switch_delay = traversal;
+  } else {
+    reservation_delay = std::max(1, route + vc_allocation);
+    switch_delay = switch_allocation + traversal;
+  }
+  body_delay = std::max(1, switch_allocation + traversal);
+  pipelined = reservation_delay > 1 || switch_delay > 0 || body_delay > 1;
+
+  vcs = relays.front().Size();
+  allocation_time.assign(relays.size() * vcs, 0);
+}
 
 std::size_t Router::TotalBufferedFlits() const {
   std::size_t count = 0;
@@ -1,6 +1,8 @@
 #pragma once
 #include <systemc.h>
 
+#include <map>
+
 #include "Hardware/Connection.hpp"
 #include "Hardware/Relay.hpp"
 #include "Hardware/ReservationTable.hpp"
@@ -14,7 +16,27 @@ class Router : public sc_module {
   SC_HAS_PROCESS(Router);
 
  private:
+  // Copy of multicast flit sent to one output with destinations reached
+  // through it
+  struct Branch {
+    Connection out;
+    std::int32_t dst_id;
+    MulticastGroup multicast;
+  };
+
   std::vector<Connection> routing_buffer;
+  std::map<Connection, std::vector<Branch>> branches;  // By reserved input
+
+  // Pipeline delays in cycles after flit arrival, see SetPipeline
+  std::int32_t reservation_delay = 1;  // Head until output VC is allocated
+  std::int32_t switch_delay = 0;       // Head from allocation to traversal
+  std::int32_t body_delay = 1;         // Body and tail until traversal
+  // Multi-stage router allocates output VC once, single cycle router may
+  // reselect output of blocked head every cycle
+  bool pipelined = false;
+  // Cycle of output VC allocation of head at each input, by port * vcs + vc
+  std::vector<double> allocation_time;
+  std::size_t vcs = 1;
 
   const RoutingAlgorithm* routing = nullptr;
   const SelectionStrategy* selection = nullptr;
@@ -24,6 +46,8 @@ class Router : public sc_module {
          std::size_t size);
 
   void Reservation(std::int32_t in_port);
+  void MulticastReservation(Connection src, const Flit& flit);
+  bool MulticastRoute(std::int32_t in_port, const std::vector<Branch>& outs);
   void Update();
 
  protected:
@@ -37,6 +61,13 @@ class Router : public sc_module {
 
   Connection FindDestination /*...unknown...*/ (const Flit& flit);
   bool Route(std::int32_t in_port, Connection dst);
+  // Counts cycle of flit waiting for output in link stats
+  void LinkStall(Connection dst);
+  // Cycles flit leaving now has queued in this router beyond pipeline
+  double RouterWait(const Flit& flit) const;
+  // Whether flit has passed pipeline stages before switch traversal
+  bool PipelineReady(Connection src, const Flit& flit) const;
+  void Allocated(Connection src);
 
   virtual void TXProcess();  // The transmitting process
   void RXProcess();          // The receiving process
@@ -58,6 +89,11 @@ class Router : public sc_module {
   void SetSelectionStrategy(const SelectionStrategy& sel);
   void SetFlitTracer(FlitTracer& tracer);
   void SetUpdateSequence(const std::vector<std::int32_t>& sequence);
+  // Cycles of route computation, VC allocation, switch allocation and
+  // switch traversal stages. Lookahead routing removes route computation
+  // from the critical path, speculation overlaps VC and switch allocation.
+  void SetPipeline(const std::vector<std::int32_t>& stages, bool lookahead,
+                   bool speculative);
 
   std::size_t Size() const { return relays.size(); }
   Relay& operator[](std::size_t i) { return relays[i]; }
@@ -5,11 +5,45 @@
 #include "Data/Flit.hpp"
 #include "Hardware/Network.hpp"
 #include "Hardware/SimulationTimer.hpp"
+#include "Metrics/DeadlockDetector.hpp"
 #include "Metrics/GlobalStats.hpp"
+#include "Metrics/Profiler.hpp"
 #include "Metrics/ProgressBar.hpp"
+#include "Routing/ChannelDependencyGraph.hpp"
 
 const static std::string Version = "0.0.1.4";
 
+static void CheckChannelDependencies(const Configuration& config,
+                                     const Network& net) {
+  std::cout << "Checking channel dependencies...";
+  auto start_time = std::chrono::high_resolution_clock::now();
+  ChannelDependencyGraph cdg(config.NetworkGraph(), config.VirtualChannels());
+  cdg.Build(net.Tiles, net.GetRoutingAlgorithm(), net.GetSelectionStrategy(),
+            config.MinPacketSize());
+  auto cycles = cdg.Cycles();
+  auto end_time = std::chrono::high_resolution_clock::now();
+  std::cout << " done in "
+            << std::chrono::duration<double>(end_time - start_time).count()
+            << "s\n";
+
+  std::cout << "% Channels: " << cdg.Channels()
+            << ", dependencies: " << cdg.Dependencies()
+            << ", cyclic components: " << cycles.size() << '\n';
+  for (const auto& cycle : cycles) {
+    std::cout << "% Cyclic dependency: ";
+    for (const auto& channel : cycle) std::cout << channel << " -> ";
+    std::cout << cycle.front() << '\n';
+  }
+
+  if (!cycles.empty() && config.ChannelDependencyCheck() == "ABORT") {
+    throw std::runtime_error(
+        "Channel dependency graph contains cycles, routing may deadlock.");
+  }
+
+  // Probing may have consumed random numbers of selection strategies
+  srand(config.RndGeneratorSeed());
+}
+
 int sc_main(int arg_num, char* arg_vet[]) {
   try {
     std::cout
@@ -33,28 +67,50 @@ int sc_main(int arg_num, char* arg_vet[]) {
     if (Config.ReportProgress())
       Bar = std::make_unique<ProgressBar>(std::cout, Timer, 20, net.clock);
 
+    std::unique_ptr<DeadlockDetector> Detector;
+    if (Config.DeadlockDetectionCycles() > 0)
+      Detector = std::make_unique<DeadlockDetector>(net, Config);
+
     net.reset.write(true);
     std::cout << "Reset for " << Config.ResetTime() << " cycles... ";
     sc_start(Config.ResetTime(), SC_NS);
     net.reset.write(false);
     std::cout << " done!\n";
 
+    // Probing requires routers to be in the reset state
+    if (Config.ChannelDependencyCheck() != "NONE") {
+      CheckChannelDependencies(Config, net);
+    }
+
     std::cout << " Now running for " << Config.SimulationTime()
               << " cycles...\n";
 
     if (Config.ReportProgress()) std::cout << " Progress: ";
+#ifdef NEWXIM_PROFILE
+    Profiler::Start();
+#endif
     auto start_time = std::chrono::high_resolution_clock::now();
     sc_start(Config.SimulationTime(), SC_NS);
     auto end_time = std::chrono::high_resolution_clock::now();
+    double seconds =
+        std::chrono::duration<double>(end_time - start_time).count();
     if (Config.ReportProgress()) std::cout << '\n';
 
     std::cout << "Newxim simulation completed.\n"
               << static_cast<std::int32_t>(Timer.SystemTime())
-              << " cycles executed in "
-              << std::chrono::duration<double>(end_time - start_time).count()
-              << "s\n\n";
+              << " cycles executed in " << seconds << "s\n";
+#ifdef NEWXIM_PROFILE
+    Profiler::Report(std::cout, Config.SimulationTime());
+#endif
+    std::cout << '\n';
+
+    if (Detector && Detector->Detected()) {
+      std::cout << *Detector;
+      throw std::runtime_error("Simulation aborted due to deadlock.");
+    }
 
     std::cout << stats;
+    if (!Config.ResultFilename().empty()) stats.WriteResult(seconds);
     return 0;
   } catch (const std::exception& ex) {
     std::cout << "Error: " << ex.what() << '\n';
@@ -0,0 +1,72 @@
+#include "DeadlockDetector.hpp"
+
+std::size_t DeadlockDetector::GetFlitsRouted() const {
+  std::size_t n = 0;
+  for (const auto& t : net_.Tiles) n += t.RouterDevice->stats.GetFlitsRouted();
+  return n;
+}
+std::size_t DeadlockDetector::GetFlitsInBuffers() const {
+  std::size_t n = 0;
+  for (const auto& t : net_.Tiles) n += t.RouterDevice->TotalBufferedFlits();
+  return n;
+}
+
+void DeadlockDetector::Update() {
+  if (reset.read() || Detected()) return;
+
+  if (++Cycles < Period) return;
+  Cycles = 0;
+
+  std::size_t routed = GetFlitsRouted();
+  if (routed != LastFlitsRouted) {
+    LastFlitsRouted = routed;
+    return;
+  }
+
+  std::size_t buffered = GetFlitsInBuffers();
+  if (!buffered) return;
+
+  DetectionTime = net_.Timer.SimulationTime();
+  FlitsStuck = buffered;
+
+  ChannelDependencyGraph graph(Config.NetworkGraph(),
+                               Config.VirtualChannels());
+  graph.Snapshot(net_.Tiles, net_.GetRoutingAlgorithm());
+  Chains = graph.Cycles();
+
+  sc_stop();
+}
+
+DeadlockDetector::DeadlockDetector(sc_module_name, const Network& network,
+                                   const Configuration& config)
+    : Config(config),
+      net_(network),
+      Period(config.DeadlockDetectionCycles()),
+      Cycles(0),
+      LastFlitsRouted(0),
+      DetectionTime(-1),
+      FlitsStuck(0) {
+  SC_METHOD(Update);
+  sensitive << reset << clock.pos();
+
+  clock(network.clock);
+  reset(network.reset);
+}
+
+bool DeadlockDetector::Detected() const { return DetectionTime >= 0; }
+
+std::ostream& operator<<(std::ostream& os, const DeadlockDetector& detector) {
+  os << "% Deadlock detected at cycle "
+     << static_cast<std::int32_t>(detector.DetectionTime)
+     << ": no flits routed for " << detector.Period << " cycles, "
+     << detector.FlitsStuck << " flits stuck in buffers.\n";
+  if (detector.Chains.empty()) {
+    os << "% Cyclic buffer chain was not found.\n";
+  }
+  for (const auto& chain : detector.Chains) {
+    os << "% Cyclic buffer chain: ";
+    for (const auto& channel : chain) os << channel << " -> ";
+    os << chain.front() << '\n';
+  }
+  return os;
+}
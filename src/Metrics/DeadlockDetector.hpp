@@ -0,0 +1,43 @@
+#pragma once
+#include <systemc.h>
+
+#include "Configuration/Configuration.hpp"
+#include "Hardware/Network.hpp"
+#include "Routing/ChannelDependencyGraph.hpp"
+
+// Stops simulation when no flit was routed for the whole detection period
+// while some flits are still buffered, and records cyclic buffer chains of
+// the wait-for graph built at that moment.
+class DeadlockDetector : public sc_module {
+  SC_HAS_PROCESS(DeadlockDetector);
+
+ private:
+  const Configuration& Config;
+  const Network& net_;
+  const std::int32_t Period;
+  std::int32_t Cycles;
+  std::size_t LastFlitsRouted;
+
+  double DetectionTime;
+  std::size_t FlitsStuck;
+  std::vector<std::vector<ChannelDependencyGraph::Channel>> Chains;
+
+  sc_in_clk clock;
+  sc_in<bool> reset;
+
+  std::size_t GetFlitsRouted() const;
+  std::size_t GetFlitsInBuffers() const;
+
+  void Update();
+  DeadlockDetector(sc_module_name, const Network& network,
+                   const Configuration& config);
+
+ public:
+  DeadlockDetector(const Network& network, const Configuration& config)
+      : DeadlockDetector("DeadlockDetector", network, config) {}
+
+  bool Detected() const;
+
+  friend std::ostream& operator<<(std::ostream& os,
+                                  const DeadlockDetector& detector);
+};
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+// Record of binary flit trace. File starts with 8 byte "NXFLITS\0" header
+// followed by records in order of simulation, little endian.
+struct FlitEvent {
+  enum Kind : std::uint8_t {
+    Inject = 0,  // Flit is sent by source processor
+    Hop = 1,     // Flit is received by router
+    Eject = 2    // Flit is received by destination processor
+  };
+
+  std::uint64_t id;     // Unique flit id
+  std::uint64_t cycle;  // Simulation time
+  std::int32_t src;
+  std::int32_t dst;
+  std::int32_t node;  // Node of the event
+  std::int16_t port;  // Input port of router, -1 for processors
+  std::int8_t vc;
+  std::uint8_t flags;  // Flit type bits, kind in bits 4-5
+
+  Kind GetKind() const { return static_cast<Kind>(flags >> 4); }
+};
+static_assert(sizeof(FlitEvent) == 32, "FlitEvent must be packed");
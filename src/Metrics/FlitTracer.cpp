@@ -1,26 +1,127 @@
 #include "FlitTracer.hpp"
 
 #include <iomanip>
+#include <stdexcept>
 
 FlitTracer::FlitTracer(const SimulationTimer& timer, double story_start,
                        double story_end)
     : Timer(timer), StoryStart(story_start), StoryEnd(story_end) {}
+FlitTracer::FlitTracer(const SimulationTimer& timer, double story_start,
+                       double story_end, const std::string& file,
+                       std::int32_t count, std::int32_t sampling,
+                       const std::vector<std::int32_t>& sources,
+                       const std::vector<std::int32_t>& destinations)
+    : FlitTracer(timer, story_start, story_end) {
+  Streaming = true;
+  FileName = file;
+  File.open(file, std::ios::out | std::ios::binary);
+  if (!File)
+    throw std::runtime_error("FlitTracer error: Can not open file [" + file +
+                             "].");
+  File.write("NXFLITS", 8);
+  Events.reserve(BufferSize);
+
+  if (sampling < 1)
+    throw std::runtime_error(
+        "FlitTracer error: Sampling period can not be less than 1.");
+  Sampling = sampling;
+  auto fill = [&](std::vector<bool>& filter,
+                  const std::vector<std::int32_t>& nodes) {
+    if (nodes.empty()) return;
+    filter.assign(count, false);
+    for (std::int32_t node : nodes) {
+      if (node < 0 || node >= count)
+        throw std::runtime_error("FlitTracer error: Invalid node [" +
+                                 std::to_string(node) + "] in filter.");
+      filter[node] = true;
+    }
+  };
+  fill(Sources, sources);
+  fill(Destinations, destinations);
+  Packets.assign(count, 0);
+  Tracing.assign(count, false);
+}
+FlitTracer::~FlitTracer() {
+  if (Streaming) Flush();
+}
+
+bool FlitTracer::InWindow(const Flit& flit) const {
+  return (StoryStart < 0 || flit.accept_timestamp >= StoryStart) &&
+         (StoryEnd < 0 || flit.accept_timestamp <= StoryEnd);
+}
+void FlitTracer::Record(const Flit& flit, std::int32_t node,
+                        std::int32_t port, FlitEvent::Kind kind) {
+  FlitEvent event;
+  event.id = flit.id;
+  event.cycle = Timer.SimulationTime();
+  event.src = flit.src_id;
+  event.dst = flit.dst_id;
+  event.node = node;
+  event.port = port;
+  event.vc = flit.vc_id;
+  event.flags = static_cast<std::uint8_t>(flit.flit_type) | (kind << 4);
+  Events.push_back(event);
+  TotalEvents++;
+  if (Events.size() == BufferSize) Flush();
+}
+void FlitTracer::Flush() {
+  File.write(reinterpret_cast<const char*>(Events.data()),
+             Events.size() * sizeof(FlitEvent));
+  File.flush();
+  Events.clear();
+}
+
+bool FlitTracer::MatchesDestination(const Flit& flit) const {
+  if (Destinations.empty()) return true;
+  if (!flit.multicast) return Destinations[flit.dst_id];
+  // Multicast packet is traced if any of its destinations is selected
+  for (std::int32_t dst : *flit.multicast) {
+    if (Destinations[dst]) return true;
+  }
+  return false;
+}
 
 void FlitTracer::Register(Flit& flit) {
-  if ((StoryStart < 0 || flit.accept_timestamp >= StoryStart) &&
-      (StoryEnd < 0 || flit.accept_timestamp <= StoryEnd)) {
+  if (Streaming) {
+    flit.id = IDOffset++;
+    // Sampling decision is made for the whole packet by its head flit
+    std::int32_t src = flit.src_id;
+    if (HasFlag(flit.flit_type, FlitType::Head)) {
+      Tracing[src] = InWindow(flit) && (Sources.empty() || Sources[src]) &&
+                     MatchesDestination(flit) &&
+                     Packets[src]++ % Sampling == 0;
+    }
+    flit.traced = Tracing[src];
+    if (flit.traced) Record(flit, src, -1, FlitEvent::Inject);
+    return;
+  }
+
+  if (InWindow(flit)) {
     flit.id = IDOffset + FlitHistory.size();
     FlitHistory.push_back(std::make_pair(flit, std::vector<Location>()));
   } else
     flit.id = IDOffset++;
 }
 void FlitTracer::Remember(const Flit& flit, std::int32_t id) {
+  if (Streaming) {
+    if (flit.traced) Record(flit, id, flit.port_in, FlitEvent::Hop);
+    return;
+  }
+
   if (flit.id - IDOffset >= FlitHistory.size() || flit.id < IDOffset) return;
   FlitHistory[flit.id - IDOffset].second.push_back(
       {id, flit.port_in, flit.vc_id, Timer.SimulationTime()});
 }
+void FlitTracer::Eject(const Flit& flit, std::int32_t id) {
+  if (Streaming && flit.traced) Record(flit, id, -1, FlitEvent::Eject);
+}
 
 std::ostream& operator<<(std::ostream& os, const FlitTracer& tracer) {
+  if (tracer.Streaming) {
+    return os << "Flit trace: " << tracer.TotalEvents
+              << " events written to file [" << tracer.FileName << "]\n";
+  }
+
   os << "Flit trace:\n";
   for (const auto& story : tracer.FlitHistory) {
     const auto& f = story.first;
@@ -1,10 +1,18 @@
 #pragma once
 #include <cstdint>
+#include <fstream>
+#include <string>
 #include <vector>
 
 #include "Data/Flit.hpp"
 #include "Hardware/SimulationTimer.hpp"
+#include "Metrics/FlitEvent.hpp"
 
+// Keeps history of flits injected during the given time window. By default
+// histories are stored in memory and printed as text at the end. In
+// streaming mode events of sampled packets are collected in fixed size
+// buffer which is written to binary file when full, so memory does not
+// depend on simulation length.
 class FlitTracer {
  public:
   struct Location {
@@ -15,17 +23,43 @@ class FlitTracer {
   };
 
  private:
+  static constexpr std::size_t BufferSize = 65536;  // Events
+
   SimulationTimer Timer;
   double StoryStart, StoryEnd;
   std::uint64_t IDOffset = 0;
   std::vector<std::pair<Flit, std::vector<Location>>> FlitHistory;
 
+  // Streaming mode
+  bool Streaming = false;
+  std::string FileName;
+  std::ofstream File;
+  std::vector<FlitEvent> Events;
+  std::size_t TotalEvents = 0;
+  std::int32_t Sampling = 1;       // Every Nth packet of each source
+  std::vector<bool> Sources;       // Filter by node, empty for all nodes
+  std::vector<bool> Destinations;  // Filter by node, empty for all nodes
+  std::vector<std::uint64_t> Packets;  // Packets injected by each source
+  std::vector<bool> Tracing;  // Current packet of each source is traced
+
+  bool InWindow(const Flit& flit) const;
+  bool MatchesDestination(const Flit& flit) const;
+  void Record(const Flit& flit, std::int32_t node, std::int32_t port,
+              FlitEvent::Kind kind);
+  void Flush();
+
  public:
   FlitTracer(const SimulationTimer& timer, double story_start,
              double story_end);
+  FlitTracer(const SimulationTimer& timer, double story_start,
+             double story_end, const std::string& file, std::int32_t count,
+             std::int32_t sampling, const std::vector<std::int32_t>& sources,
+             const std::vector<std::int32_t>& destinations);
+  ~FlitTracer();
 
   void Register(Flit& flit);
   void Remember(const Flit& flit, std::int32_t id);
+  void Eject(const Flit& flit, std::int32_t id);
 
   friend std::ostream& operator<<(std::ostream& os, const FlitTracer& tracer);
-};
\ No newline at end of file
+};
@@ -0,0 +1,57 @@
+#include "FlowMatrix.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+FlowMatrix::FlowMatrix(std::size_t nodes) : Nodes(nodes) {
+  if (nodes <= DenseNodes) Dense.resize(nodes * nodes);
+}
+
+std::vector<std::pair<std::uint64_t, FlowMatrix::Flow>> FlowMatrix::Active()
+    const {
+  std::vector<std::pair<std::uint64_t, Flow>> result;
+  auto add = [&](std::uint64_t key, const Flow& flow) {
+    if (flow.injected || flow.packets) result.emplace_back(key, flow);
+  };
+  for (std::uint64_t key = 0; key < Dense.size(); key++) add(key, Dense[key]);
+  for (const auto& [key, flow] : Sparse) add(key, flow);
+  std::sort(result.begin(), result.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  return result;
+}
+
+std::size_t FlowMatrix::Starved() const {
+  std::size_t starved = 0;
+  for (const auto& [key, flow] : Active())
+    starved += flow.injected && !flow.packets;
+  return starved;
+}
+double FlowMatrix::Fairness() const {
+  double sum = 0, squares = 0;
+  auto flows = Active();
+  for (const auto& [key, flow] : flows) {
+    sum += flow.flits;
+    squares += static_cast<double>(flow.flits) * flow.flits;
+  }
+  return squares > 0 ? sum * sum / (flows.size() * squares) : 1;
+}
+
+void FlowMatrix::Write(const std::string& file, double cycles) const {
+  std::ofstream fout(file);
+  if (!fout)
+    throw std::runtime_error("FlowMatrix error: Unable to open file [" + file +
+                             "].");
+  fout << "src,dst,injected_packets,received_packets,throughput_flits_cycle,"
+          "average_delay_cycles,max_delay_cycles,average_hops\n";
+  for (const auto& [key, flow] : Active()) {
+    fout << key / Nodes << ',' << key % Nodes << ',' << flow.injected << ','
+         << flow.packets << ',' << flow.flits / cycles << ',';
+    if (flow.packets) {
+      fout << flow.delay / flow.packets << ',' << flow.max_delay << ','
+           << static_cast<double>(flow.hops) / flow.packets << '\n';
+    } else {
+      fout << ",,\n";
+    }
+  }
+}
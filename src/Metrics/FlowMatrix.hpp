@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Packet statistics of each (source, destination) flow. Flows are kept in
+// dense matrix for networks up to DenseNodes nodes, larger networks keep
+// only flows which carried traffic in hash map.
+class FlowMatrix {
+ public:
+  static constexpr std::size_t DenseNodes = 256;
+
+  struct Flow {
+    std::uint64_t injected = 0;  // Packets injected to network
+    std::uint64_t packets = 0;   // Packets received
+    std::uint64_t flits = 0;     // Flits of received packets
+    std::uint64_t hops = 0;      // Links between routers of received packets
+    double delay = 0;            // Total delay of received packets
+    double max_delay = 0;
+  };
+
+ private:
+  const std::size_t Nodes;
+  std::vector<Flow> Dense;
+  std::unordered_map<std::uint64_t, Flow> Sparse;
+
+  Flow& At(std::int32_t src, std::int32_t dst) {
+    std::uint64_t key = static_cast<std::uint64_t>(src) * Nodes + dst;
+    return Dense.empty() ? Sparse[key] : Dense[key];
+  }
+
+ public:
+  explicit FlowMatrix(std::size_t nodes);
+
+  void Inject(std::int32_t src, std::int32_t dst) { At(src, dst).injected++; }
+  void Receive(std::int32_t src, std::int32_t dst, std::int32_t flits,
+               std::int32_t hops, double delay) {
+    Flow& flow = At(src, dst);
+    flow.packets++;
+    flow.flits += flits;
+    flow.hops += hops;
+    flow.delay += delay;
+    if (delay > flow.max_delay) flow.max_delay = delay;
+  }
+
+  // Flows which carried traffic ordered by source and destination
+  std::vector<std::pair<std::uint64_t, Flow>> Active() const;
+  std::size_t Size() const { return Nodes; }
+
+  // Flows with injected packets and no packet received
+  std::size_t Starved() const;
+  // Jain's fairness index of flits received by active flows
+  double Fairness() const;
+
+  // Writes CSV row for each active flow, throughput is divided by cycles
+  void Write(const std::string& file, double cycles) const;
+};
@@ -1,51 +1,159 @@
 #include "GlobalStats.hpp"
 
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <iostream>
+#include <thread>
+
+#include "Configuration/TrafficManagers/BurstyTrafficManager.hpp"
+#include "Configuration/TrafficManagers/MulticastTrafficManager.hpp"
+#include "Configuration/TrafficManagers/TaskGraphTrafficManager.hpp"
+#include "Metrics/Profiler.hpp"
+
+// Tiles are reduced in fixed chunks merged in order, so floating point sums
+// do not depend on the number of threads. Chunks are spread over threads
+// only for networks large enough to outweigh thread start.
+template <typename Result, typename Body, typename Merge>
+static Result ReduceTiles(const std::vector<Tile>& tiles, Body body,
+                          Merge merge) {
+  constexpr std::size_t ChunkTiles = 1024;
+  std::size_t chunks = (tiles.size() + ChunkTiles - 1) / ChunkTiles;
+  std::vector<Result> partial(chunks);
+  std::atomic<std::size_t> next = 0;
+  auto run = [&] {
+    for (std::size_t c; (c = next++) < chunks;) {
+      std::size_t end = std::min(tiles.size(), (c + 1) * ChunkTiles);
+      for (std::size_t i = c * ChunkTiles; i < end; i++)
+        body(tiles[i], partial[c]);
+    }
+  };
+  std::size_t threads =
+      std::min<std::size_t>(std::thread::hardware_concurrency(), chunks);
+  std::vector<std::thread> workers;
+  for (std::size_t t = 1; t < threads; t++) workers.emplace_back(run);
+  run();
+  for (auto& worker : workers) worker.join();
+
+  Result result{};
+  for (const Result& chunk : partial) merge(result, chunk);
+  return result;
+}
+
+void GlobalStats::Totals::Merge(const Totals& other) {
+  flits_produced += other.flits_produced;
+  flits_accepted += other.flits_accepted;
+  flits_received += other.flits_received;
+  actual_flits_accepted += other.actual_flits_accepted;
+  actual_flits_received += other.actual_flits_received;
+  flits_in_buffers += other.flits_in_buffers;
+  flits_in_transmission += other.flits_in_transmission;
+  deliveries_sent += other.deliveries_sent;
+  deliveries_pending += other.deliveries_pending;
+  packets_received += other.packets_received;
+  packets_dropped += other.packets_dropped;
+  transactions += other.transactions;
+  last_received_time = std::max(last_received_time, other.last_received_time);
+  max_buffer_stuck_delay =
+      std::max(max_buffer_stuck_delay, other.max_buffer_stuck_delay);
+  max_time_in_network =
+      std::max(max_time_in_network, other.max_time_in_network);
+  max_delay = std::max(max_delay, other.max_delay);
+  max_round_trip = std::max(max_round_trip, other.max_round_trip);
+  delay += other.delay;
+  queue_delay += other.queue_delay;
+  router_wait += other.router_wait;
+  traversal += other.traversal;
+  serialization += other.serialization;
+  round_trip += other.round_trip;
+  buffer_load += other.buffer_load;
+  delays.Merge(other.delays);
+}
+
+void GlobalStats::FinishStats() const {
+  double window = Config.SimulationTime() - Config.StatsWarmUpTime();
+  auto body = [&](const Tile& t, Totals& totals) {
+    const Processor& processor = *t.ProcessorDevice;
+    Router& router = *t.RouterDevice;
+    totals.flits_produced += processor.FlitsProduced();
+    totals.flits_accepted += processor.FlitsSent();
+    totals.flits_received += processor.FlitsReceived();
+    totals.actual_flits_accepted += processor.ActualFlitsSent();
+    totals.actual_flits_received += processor.ActualFlitsReceived();
+    totals.deliveries_sent += processor.ActualDeliveriesSent();
+    totals.packets_dropped += processor.PacketsDropped();
+    totals.last_received_time =
+        std::max(totals.last_received_time, processor.LastReceivedFlitTime());
+    totals.max_time_in_network =
+        std::max(totals.max_time_in_network, processor.MaxTimeFlitInNetwork());
+    totals.max_round_trip =
+        std::max(totals.max_round_trip, processor.MaxRoundTrip());
+    totals.delays.Merge(processor.Delays());
+
+    // Averages of processors without packets are undefined
+    if (std::size_t packets = processor.PacketsReceived()) {
+      totals.packets_received += packets;
+      totals.delay += packets * processor.AverageDelay();
+      totals.queue_delay += packets * processor.AverageQueueDelay();
+      totals.router_wait += packets * processor.AverageRouterWait();
+      totals.traversal += packets * processor.AverageTraversalDelay();
+      totals.serialization += packets * processor.AverageSerializationDelay();
+      totals.max_delay = std::max(totals.max_delay, processor.MaxDelay());
+    }
+    if (std::size_t transactions = processor.Transactions()) {
+      totals.transactions += transactions;
+      totals.round_trip += transactions * processor.AverageRoundTripDelay();
+    }
+
+    totals.flits_in_transmission += processor.relay.InTransit();
+    totals.deliveries_pending += processor.relay.InTransitDeliveries();
+    for (std::size_t r = 0; r < router.Size(); r++) {
+      const Relay& relay = router[r];
+      totals.flits_in_transmission += relay.InTransit();
+      totals.deliveries_pending += relay.InTransitDeliveries();
+      for (std::size_t vc = 0; vc < relay.Size(); vc++) {
+        router.stats.StopStuckTimer(r, vc);
+        const Buffer& buffer = relay[vc];
+        if (buffer.Empty()) continue;
+        totals.flits_in_buffers += buffer.Size();
+        totals.deliveries_pending += buffer.Deliveries();
+        totals.max_time_in_network =
+            std::max(totals.max_time_in_network,
+                     window - buffer.GetOldestAccepted());
+      }
+    }
+    totals.max_buffer_stuck_delay = std::max(
+        totals.max_buffer_stuck_delay, router.stats.GetMaxBufferStuckDelay());
+    totals.buffer_load += router.stats.GetAverageBufferLoad();
+  };
+  Final = ReduceTiles<Totals>(
+      net_.Tiles, body,
+      [](Totals& result, const Totals& chunk) { result.Merge(chunk); });
+}
 
 std::size_t GlobalStats::GetActualFlitsReceived() const {
-  std::size_t n = 0;
-  for (const auto& t : net_.Tiles)
-    n += t.ProcessorDevice->ActualFlitsReceived();
-  return n;
+  return Final.actual_flits_received;
 }
 std::size_t GlobalStats::GetActualFlitsAccepted() const {
-  std::size_t n = 0;
-  for (const auto& t : net_.Tiles) n += t.ProcessorDevice->ActualFlitsSent();
-  return n;
+  return Final.actual_flits_accepted;
 }
 std::size_t GlobalStats::GetFlitsInBuffers() const {
-  std::size_t count = 0;
-  for (const auto& t : net_.Tiles)
-    count += t.RouterDevice->TotalBufferedFlits();
-  return count;
+  return Final.flits_in_buffers;
 }
 std::size_t GlobalStats::GetFlitsInTransmission() const {
-  std::size_t count = 0;
-  for (const auto& t : net_.Tiles) {
-    for (std::size_t r = 0; r < t.RouterDevice->Size(); r++)
-      if ((*t.RouterDevice)[r].CanReceive()) count++;
-
-    if ((*t.ProcessorDevice).relay.CanReceive()) count++;
-  }
-  return count;
+  return Final.flits_in_transmission;
 }
 
 std::size_t GlobalStats::GetFlitsProduced() const {
-  std::size_t result = 0;
-  for (const auto& t : net_.Tiles)
-    result += t.ProcessorDevice->FlitsProduced();
-  return result;
+  return Final.flits_produced;
 }
 std::size_t GlobalStats::GetFlitsAccepted() const {
-  std::size_t n = 0;
-  for (const auto& t : net_.Tiles) n += t.ProcessorDevice->FlitsSent();
-  return n;
+  return Final.flits_accepted;
 }
 std::size_t GlobalStats::GetFlitsReceived() const {
-  std::size_t n = 0;
-  for (const auto& t : net_.Tiles) n += t.ProcessorDevice->FlitsReceived();
-  return n;
+  return Final.flits_received;
 }
 double GlobalStats::GetProduction() const {
   std::size_t total_cycles = Config.SimulationTime() - Config.StatsWarmUpTime();
@@ -67,87 +175,84 @@ double GlobalStats::GetAcceptance() const {
 }
 
 std::size_t GlobalStats::GetLastReceivedFlitTime() const {
-  double result = 0.0;
-  for (const auto& t : net_.Tiles)
-    if (t.ProcessorDevice->LastReceivedFlitTime() > result)
-      result = t.ProcessorDevice->LastReceivedFlitTime();
-  return static_cast<std::size_t>(result);
+  return static_cast<std::size_t>(Final.last_received_time);
 }
 std::size_t GlobalStats::GetMaxBufferStuckDelay() const {
-  double max_delay = -1;
-  for (const auto& t : net_.Tiles) {
-    double delay = t.RouterDevice->stats.GetMaxBufferStuckDelay();
-    if (delay > max_delay) max_delay = delay;
-  }
-  return static_cast<std::size_t>(max_delay);
+  return static_cast<std::size_t>(Final.max_buffer_stuck_delay);
 }
 std::size_t GlobalStats::GetMaxTimeFlitInNetwork() const {
-  double result = 0.0;
-  for (const auto& t : net_.Tiles) {
-    if (t.ProcessorDevice->MaxTimeFlitInNetwork() > result)
-      result = t.ProcessorDevice->MaxTimeFlitInNetwork();
-
-    for (std::size_t r = 0; r < t.RouterDevice->Size(); r++) {
-      const auto& relay = (*t.RouterDevice)[r];
-
-      for (std::size_t vc = 0; vc < relay.Size(); vc++) {
-        const auto& buffer = relay[vc];
-        if (!buffer.Empty()) {
-          double span = Config.SimulationTime() - Config.StatsWarmUpTime() -
-                        relay[vc].GetOldestAccepted();
-          if (span > result) result = span;
-        }
-      }
-    }
-  }
-
-  return static_cast<std::size_t>(result);
+  return static_cast<std::size_t>(Final.max_time_in_network);
 }
 
 std::size_t GlobalStats::GetPacketsReceived() const {
-  std::int32_t n = 0;
-
-  for (const auto& t : net_.Tiles) n += t.ProcessorDevice->PacketsReceived();
-
-  return n;
+  return Final.packets_received;
+}
+LatencyHistogram GlobalStats::GetDelayHistogram() const {
+  return Final.delays;
+}
+std::size_t GlobalStats::GetPacketsDropped() const {
+  return Final.packets_dropped;
 }
 std::size_t GlobalStats::GetFlitsLost() const {
-  std::size_t accepted = GetActualFlitsAccepted();
-  std::size_t received = GetActualFlitsReceived();
-  std::size_t buffered = GetFlitsInBuffers();
-  std::size_t transmitting = GetFlitsInTransmission();
-  return accepted - received - buffered - transmitting;
+  // Multicast flit is received by each destination, so flits are counted
+  // by their expected deliveries
+  return Final.deliveries_sent - GetActualFlitsReceived() -
+         Final.deliveries_pending;
 }
 
 double GlobalStats::GetAverageDelay() const {
-  std::size_t total_packets = 0;
-  double avg_delay = 0.0;
+  return Final.packets_received ? Final.delay / Final.packets_received : 0.0;
+}
+double GlobalStats::GetAverageQueueDelay() const {
+  return Final.packets_received ? Final.queue_delay / Final.packets_received
+                                : 0.0;
+}
+double GlobalStats::GetAverageNetworkDelay() const {
+  return GetAverageDelay() - GetAverageQueueDelay();
+}
+double GlobalStats::GetAverageRouterWait() const {
+  return Final.packets_received ? Final.router_wait / Final.packets_received
+                                : 0.0;
+}
+double GlobalStats::GetAverageTraversalDelay() const {
+  return Final.packets_received ? Final.traversal / Final.packets_received
+                                : 0.0;
+}
+double GlobalStats::GetAverageSerializationDelay() const {
+  return Final.packets_received ? Final.serialization / Final.packets_received
+                                : 0.0;
+}
+double GlobalStats::GetMaxDelay() const { return Final.max_delay; }
 
-  for (const auto& t : net_.Tiles) {
-    std::size_t received_packets = t.ProcessorDevice->PacketsReceived();
-    if (received_packets) {
-      avg_delay += received_packets * t.ProcessorDevice->AverageDelay();
-      total_packets += received_packets;
-    }
-  }
+const TaskGraphTrafficManager* GlobalStats::GetTaskGraph() const {
+  return dynamic_cast<const TaskGraphTrafficManager*>(
+      &net_.GetTrafficManager());
+}
 
-  if (total_packets != 0) {
-    avg_delay /= static_cast<double>(total_packets);
-  }
+const MulticastTrafficManager* GlobalStats::GetMulticast() const {
+  const TrafficManager* traffic = &net_.GetTrafficManager();
+  if (auto bursty = dynamic_cast<const BurstyTrafficManager*>(traffic))
+    traffic = &bursty->Distribution();
+  return dynamic_cast<const MulticastTrafficManager*>(traffic);
+}
+double GlobalStats::GetMulticastAmplification() const {
+  return static_cast<double>(GetFlitsReceived()) /
+         static_cast<double>(GetFlitsAccepted());
+}
 
-  return avg_delay;
+std::size_t GlobalStats::GetTransactions() const {
+  return Final.transactions;
 }
-double GlobalStats::GetMaxDelay() const {
-  double maxd = -1.0;
-  for (std::size_t i = 0; i < net_.Tiles.size(); i++) {
-    double d = -1;
-    std::size_t received_packets =
-        net_.Tiles[i].ProcessorDevice->PacketsReceived();
-    if (received_packets) d = net_.Tiles[i].ProcessorDevice->MaxDelay();
-    ;
-    if (d > maxd) maxd = d;
-  }
-  return maxd;
+double GlobalStats::GetTransactionThroughput() const {
+  std::size_t total_cycles = Config.SimulationTime() - Config.StatsWarmUpTime();
+  return static_cast<double>(GetTransactions()) /
+         static_cast<double>(total_cycles);
+}
+double GlobalStats::GetAverageRoundTripDelay() const {
+  return Final.transactions ? Final.round_trip / Final.transactions : 0.0;
+}
+double GlobalStats::GetMaxRoundTripDelay() const {
+  return Final.max_round_trip;
 }
 
 double GlobalStats::GetAverageBufferLoad(std::size_t relay,
@@ -158,10 +263,7 @@ double GlobalStats::GetAverageBufferLoad(std::size_t relay,
   return sum / net_.Tiles.size();
 }
 double GlobalStats::GetAverageBufferLoad() const {
-  double sum = 0;
-  for (const auto& t : net_.Tiles)
-    sum += t.RouterDevice->stats.GetAverageBufferLoad();
-  return sum / net_.Tiles.size();
+  return Final.buffer_load / net_.Tiles.size();
 }
 
 void GlobalStats::ShowBuffers(std::ostream& out) const {
@@ -195,40 +297,192 @@ void GlobalStats::ShowDistribution(std::ostream& out) const {
   }
 }
 
-void GlobalStats::Update() {
-  // if (net_.Timer.SimulationTime() < Config.SimulationTime() - 10) return;
-  //
-  // std::cout << "Cycle " << net_.Timer.SimulationTime() << ":\n";
-  // ShowBuffers(std::cout);
-  //
-  // for (const auto& tile : net_.Tiles)
-  //{
-  //	auto rt = tile.RouterDevice->GetReservationTable();
-  //	if (rt)
-  //	{
-  //		std::cout << "Reservation table " << tile.RouterDevice->LocalID <<
-  //":\n"; 		std::cout << *rt;
-  //	}
-  // }
+void GlobalStats::ShowLatencyBreakdown(std::ostream& out) const {
+  auto show = [&](const LatencyHistogram& histogram, std::int32_t id) {
+    out << std::setfill('0') << std::setw(4) << id << ':';
+    for (double p : DelayPercentiles) out << ' ' << histogram.Percentile(p);
+    out << '\n';
+  };
+  out << "% Delay percentiles by source (p50 p95 p99 p99.9):\n";
+  for (std::int32_t id = 0; id < net_.SourceDelays.size(); id++)
+    show(net_.SourceDelays[id], id);
+  out << "% Delay percentiles by destination (p50 p95 p99 p99.9):\n";
+  for (auto& tile : net_.Tiles)
+    show(tile.ProcessorDevice->Delays(), tile.ProcessorDevice->local_id);
 }
 
-void GlobalStats::FinishStats() const {
+void GlobalStats::ShowLinks(std::ostream& out) const {
+  double total_cycles = Config.SimulationTime() - Config.StatsWarmUpTime();
+  out << "% Link statistics:\n";
   for (std::size_t i = 0; i < Config.TopologyGraph().size(); i++) {
     auto& node = Config.TopologyGraph()[i];
-    auto& stats = net_.Tiles[i].RouterDevice->stats;
-    for (std::size_t r = 0; r < net_.Tiles[i].RouterDevice->Size(); r++) {
-      const auto& relay = (*net_.Tiles[i].RouterDevice)[r];
-      for (std::size_t vc = 0; vc < relay.Size(); vc++) {
-        stats.StopStuckTimer(r, vc);
+    const Router& router = *net_.Tiles[i].RouterDevice;
+    for (std::size_t r = 0; r < router.Size(); r++) {
+      for (std::size_t vc = 0; vc < router[r].Size(); vc++) {
+        std::uint64_t traversals = router.stats.GetLinkTraversals(r, vc);
+        out << '[' << i << "--(" << r << ':' << vc << ")->";
+        if (r < node.size())
+          out << node[r];
+        else
+          out << 'L';
+        out << "]: T(" << traversals << ") U(" << traversals / total_cycles
+            << ") B(" << router.stats.GetLinkBlocked(r, vc) << ") C("
+            << router.stats.GetLinkCreditStalls(r, vc) << ")\n";
+      }
+    }
+  }
+}
+
+void GlobalStats::ShowDelayComponents(std::ostream& out) const {
+  out << "% Average delay components (cycles):\n";
+  out << "source queueing: " << GetAverageQueueDelay() << '\n';
+  out << "router queueing: " << GetAverageRouterWait() << '\n';
+  out << "traversal: " << GetAverageTraversalDelay() << '\n';
+  out << "serialization: " << GetAverageSerializationDelay() << '\n';
+  // Share is taken from queueing of all head flits in the network
+  double total_wait = 0;
+  for (const auto& t : net_.Tiles)
+    total_wait += t.RouterDevice->stats.GetTotalHeadWait();
+  out << "% Router queueing of head flits (heads, average, share):\n";
+  for (const auto& t : net_.Tiles) {
+    const Stats& stats = t.RouterDevice->stats;
+    std::uint64_t heads = stats.GetHeadsRouted();
+    double wait = stats.GetTotalHeadWait();
+    out << std::setfill('0') << std::setw(4) << t.RouterDevice->LocalId
+        << ": H(" << heads << ") W(" << (heads ? wait / heads : 0) << ") S("
+        << (total_wait > 0 ? wait / total_wait : 0) << ")\n";
+  }
+}
+
+void GlobalStats::Update() {
+  PROFILE_SCOPE(GlobalStatsUpdate);
+  if (reset.read()) return;
+  std::int64_t cycle = net_.Timer.SimulationTime();
+  if (cycle <= 0 || cycle % Config.CycleResultPeriod()) return;
+
+  // Counters are summed over the whole network only once per period
+  using Sample = TimeSeriesWriter::Sample;
+  auto body = [](const Tile& t, Sample& sample) {
+    const Processor& processor = *t.ProcessorDevice;
+    sample.injected += processor.ActualFlitsProduced();
+    sample.accepted += processor.ActualFlitsSent();
+    sample.received += processor.ActualFlitsReceived();
+    sample.buffered += t.RouterDevice->TotalBufferedFlits();
+    sample.in_flight += processor.ActualPacketsSent();
+    sample.in_flight -= processor.ActualPacketsReceived();
+  };
+  auto merge = [](Sample& result, const Sample& chunk) {
+    result.injected += chunk.injected;
+    result.accepted += chunk.accepted;
+    result.received += chunk.received;
+    result.buffered += chunk.buffered;
+    result.in_flight += chunk.in_flight;
+  };
+  Sample sample = ReduceTiles<Sample>(net_.Tiles, body, merge);
+  sample.cycle = cycle;
+  sample.occupancy = static_cast<double>(sample.buffered) / BufferSlots;
+
+  TimeSeriesWriter::Sample totals = sample;
+  sample.injected -= LastSample.injected;
+  sample.accepted -= LastSample.accepted;
+  sample.received -= LastSample.received;
+  LastSample = totals;
+  Series->Push(sample);
+}
+
+void GlobalStats::WriteGlobal(ResultWriter& out) const {
+  out.Begin("global");
+  out.Field("total_produced_flits", GetFlitsProduced());
+  out.Field("total_accepted_flits", GetFlitsAccepted());
+  out.Field("total_received_flits", GetFlitsReceived());
+  out.Field("network_production_flits_cycle", GetProduction());
+  out.Field("network_acceptance_flits_cycle", GetAcceptance());
+  out.Field("network_throughput_flits_cycle", GetThroughput());
+  out.Field("ip_throughput_flits_cycle_ip", GetIPThroughput());
+  out.Field("last_time_flit_received_cycles", GetLastReceivedFlitTime());
+  out.Field("max_buffer_stuck_delay_cycles", GetMaxBufferStuckDelay());
+  out.Field("max_time_flit_in_network_cycles", GetMaxTimeFlitInNetwork());
+  out.Field("total_received_packets", GetPacketsReceived());
+  out.Field("total_flits_lost", GetFlitsLost());
+  out.Field("total_packets_dropped", GetPacketsDropped());
+  out.Field("global_average_delay_cycles", GetAverageDelay());
+  out.Field("average_queue_delay_cycles", GetAverageQueueDelay());
+  out.Field("average_network_delay_cycles", GetAverageNetworkDelay());
+  out.Field("max_delay_cycles", GetMaxDelay());
+  LatencyHistogram delays = GetDelayHistogram();
+  out.Field("delay_p50_cycles", delays.Percentile(50));
+  out.Field("delay_p95_cycles", delays.Percentile(95));
+  out.Field("delay_p99_cycles", delays.Percentile(99));
+  out.Field("delay_p99_9_cycles", delays.Percentile(99.9));
+  out.Field("average_buffer_utilization", GetAverageBufferLoad());
+  out.End();
+}
+
+void GlobalStats::WriteResult(double seconds) const {
+  FinishStats();
+  ResultWriter out(Config.ResultFilename(),
+                   Config.ResultFormat() == "CSV"
+                       ? ResultWriter::Format::Csv
+                       : ResultWriter::Format::JsonLines);
+
+  out.Begin("config");
+  for (const auto& [name, value] : Config.Parameters()) out.Field(name, value);
+  out.End();
+
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  out.Begin("runtime");
+  out.Field("cycles", static_cast<std::int64_t>(net_.Timer.SystemTime()));
+  out.Field("seconds", seconds);
+  out.Field("cycles_per_second", net_.Timer.SystemTime() / seconds);
+  out.Field("peak_rss_kb", static_cast<std::int64_t>(usage.ru_maxrss));
+  out.End();
+
+  WriteGlobal(out);
+
+  // Local ports are keyed by -1 source
+  for (std::size_t i = 0; i < net_.Tiles.size(); i++) {
+    auto& node = Config.TopologyGraph()[i];
+    Router& router = *net_.Tiles[i].RouterDevice;
+    for (std::size_t r = 0; r < router.Size(); r++) {
+      for (std::size_t vc = 0; vc < router[r].Size(); vc++) {
+        out.Begin("buffer", i, r, vc);
+        out.Field("from", r < node.size() ? node[r] : -1);
+        out.Field("received", router.stats.GetBufferFlitsReceived(r, vc));
+        out.Field("max_stuck_delay",
+                  router.stats.GetMaxBufferStuckDelay(r, vc));
+        out.Field("average_load", router.stats.GetAverageBufferLoad(r, vc));
+        out.Field("flits", router[r][vc].Size());
+        out.End();
       }
     }
   }
+
+  for (const auto& tile : net_.Tiles) {
+    const Processor& processor = *tile.ProcessorDevice;
+    out.Begin("node", processor.local_id);
+    out.Field("received_flits", processor.FlitsReceived());
+    out.Field("sent_flits", processor.FlitsSent());
+    out.Field("received_packets", processor.PacketsReceived());
+    out.Field("average_delay", processor.AverageDelay());
+    out.End();
+  }
 }
 
 GlobalStats::GlobalStats(sc_module_name name, const ::Network& network,
                          const Configuration& config)
     : net_(network), Config(config) {
   if (config.ReportCycleResult()) {
+    Series = std::make_unique<TimeSeriesWriter>(
+        config.CycleResultFilename(), config.CycleResultFormat() == "BINARY");
+    for (const auto& t : network.Tiles) {
+      const Router& router = *t.RouterDevice;
+      for (std::size_t i = 0; i < router.Size(); i++) {
+        for (std::size_t vc = 0; vc < router[i].Size(); vc++)
+          BufferSlots += router[i][vc].GetCapacity();
+      }
+    }
+
     SC_METHOD(Update);
     sensitive << reset << clock.pos();
   }
@@ -237,8 +491,20 @@ GlobalStats::GlobalStats(sc_module_name name, const ::Network& network,
   reset(network.reset);
 }
 
+static std::string JsonPercentiles(const LatencyHistogram& histogram) {
+  std::stringstream ss;
+  for (double p : DelayPercentiles)
+    ss << (p == DelayPercentiles[0] ? '[' : ',') << histogram.Percentile(p);
+  ss << ']';
+  return ss.str();
+}
+
 std::ostream& operator<<(std::ostream& out, const GlobalStats& gs) {
   gs.FinishStats();
+  if (gs.net_.Flows) {
+    double cycles = gs.Config.SimulationTime() - gs.Config.StatsWarmUpTime();
+    gs.net_.Flows->Write(gs.Config.FlowMatrixFilename(), cycles);
+  }
 
   if (gs.Config.JsonResult()) {
     out << "% Result: ";
@@ -258,9 +524,97 @@ std::ostream& operator<<(std::ostream& out, const GlobalStats& gs) {
         << gs.GetMaxTimeFlitInNetwork() << ",";
     out << "\"total_received_packets\":" << gs.GetPacketsReceived() << ",";
     out << "\"total_flits_lost\":" << gs.GetFlitsLost() << ",";
+    out << "\"total_packets_dropped\":" << gs.GetPacketsDropped() << ",";
     out << "\"global_average_delay_cycles\":" << gs.GetAverageDelay() << ",";
+    out << "\"average_queue_delay_cycles\":" << gs.GetAverageQueueDelay()
+        << ",";
+    out << "\"average_network_delay_cycles\":" << gs.GetAverageNetworkDelay()
+        << ",";
     out << "\"max_delay_cycles\":" << gs.GetMaxDelay() << ",";
+    LatencyHistogram delays = gs.GetDelayHistogram();
+    out << "\"delay_p50_cycles\":" << delays.Percentile(50) << ",";
+    out << "\"delay_p95_cycles\":" << delays.Percentile(95) << ",";
+    out << "\"delay_p99_cycles\":" << delays.Percentile(99) << ",";
+    out << "\"delay_p99_9_cycles\":" << delays.Percentile(99.9) << ",";
+    if (gs.Config.ReportLatencyBreakdown()) {
+      const auto& tiles = gs.net_.Tiles;
+      out << "\"delay_percentiles_by_source\":[";
+      for (std::size_t id = 0; id < tiles.size(); id++)
+        out << (id ? "," : "") << JsonPercentiles(gs.net_.SourceDelays[id]);
+      out << "],";
+      out << "\"delay_percentiles_by_destination\":[";
+      for (std::size_t id = 0; id < tiles.size(); id++)
+        out << (id ? "," : "")
+            << JsonPercentiles(tiles[id].ProcessorDevice->Delays());
+      out << "],";
+    }
+    if (gs.Config.ReportLinks()) {
+      // Local ports are keyed by -1 destination
+      out << "\"links\":[";
+      bool first = true;
+      for (std::size_t i = 0; i < gs.net_.Tiles.size(); i++) {
+        auto& node = gs.Config.TopologyGraph()[i];
+        const Router& router = *gs.net_.Tiles[i].RouterDevice;
+        for (std::size_t r = 0; r < router.Size(); r++) {
+          for (std::size_t vc = 0; vc < router[r].Size(); vc++) {
+            out << (first ? "" : ",") << "{\"from\":" << i << ",\"to\":"
+                << (r < node.size() ? node[r] : -1) << ",\"port\":" << r
+                << ",\"vc\":" << vc << ",\"traversals\":"
+                << router.stats.GetLinkTraversals(r, vc) << ",\"blocked\":"
+                << router.stats.GetLinkBlocked(r, vc)
+                << ",\"credit_stalls\":"
+                << router.stats.GetLinkCreditStalls(r, vc) << "}";
+            first = false;
+          }
+        }
+      }
+      out << "],";
+    }
+    if (gs.Config.ReportDelayComponents()) {
+      out << "\"average_router_queueing_delay_cycles\":"
+          << gs.GetAverageRouterWait() << ",";
+      out << "\"average_traversal_delay_cycles\":"
+          << gs.GetAverageTraversalDelay() << ",";
+      out << "\"average_serialization_delay_cycles\":"
+          << gs.GetAverageSerializationDelay() << ",";
+      out << "\"router_head_wait_cycles\":[";
+      for (std::size_t i = 0; i < gs.net_.Tiles.size(); i++) {
+        const Stats& stats = gs.net_.Tiles[i].RouterDevice->stats;
+        out << (i ? "," : "") << "{\"heads\":" << stats.GetHeadsRouted()
+            << ",\"total\":" << stats.GetTotalHeadWait() << "}";
+      }
+      out << "],";
+    }
     out << "\"average_buffer_utilization\":" << gs.GetAverageBufferLoad() << "";
+    if (auto graph = gs.GetTaskGraph()) {
+      double end = gs.Config.SimulationTime();
+      out << ",\"completed_tasks\":" << graph->CompletedTasks(end) << ",";
+      out << "\"total_tasks\":" << graph->TotalTasks() << ",";
+      out << "\"makespan_cycles\":" << graph->Makespan(end);
+    }
+    if (auto multicast = gs.GetMulticast()) {
+      out << ",\"multicast_delivered_packets\":" << multicast->Delivered()
+          << ",";
+      out << "\"multicast_amplification\":"
+          << gs.GetMulticastAmplification() << ",";
+      out << "\"multicast_average_delivery_delay_cycles\":"
+          << multicast->AverageDeliveryDelay() << ",";
+      out << "\"multicast_max_delivery_delay_cycles\":"
+          << multicast->MaxDelay();
+    }
+    if (gs.Config.ClosedLoop()) {
+      out << ",\"total_transactions\":" << gs.GetTransactions() << ",";
+      out << "\"transaction_throughput_cycle\":"
+          << gs.GetTransactionThroughput() << ",";
+      out << "\"average_round_trip_delay_cycles\":"
+          << gs.GetAverageRoundTripDelay() << ",";
+      out << "\"max_round_trip_delay_cycles\":" << gs.GetMaxRoundTripDelay();
+    }
+    if (auto& flows = gs.net_.Flows) {
+      out << ",\"flows_active\":" << flows->Active().size() << ",";
+      out << "\"flows_starved\":" << flows->Starved() << ",";
+      out << "\"flow_fairness\":" << flows->Fairness();
+    }
     out << "}";
   } else {
     out << "% Total produced flits: " << gs.GetFlitsProduced() << '\n';
@@ -278,10 +632,49 @@ std::ostream& operator<<(std::ostream& out, const GlobalStats& gs) {
         << gs.GetMaxTimeFlitInNetwork() << '\n';
     out << "% Total received packets: " << gs.GetPacketsReceived() << '\n';
     out << "% Total flits lost: " << gs.GetFlitsLost() << '\n';
+    out << "% Total packets dropped: " << gs.GetPacketsDropped() << '\n';
     out << "% Global average delay (cycles): " << gs.GetAverageDelay() << '\n';
+    out << "% Average source queueing delay (cycles): "
+        << gs.GetAverageQueueDelay() << '\n';
+    out << "% Average network delay (cycles): " << gs.GetAverageNetworkDelay()
+        << '\n';
     out << "% Max delay (cycles): " << gs.GetMaxDelay() << '\n';
+    LatencyHistogram delays = gs.GetDelayHistogram();
+    out << "% Delay percentiles p50/p95/p99/p99.9 (cycles): "
+        << delays.Percentile(50) << " / " << delays.Percentile(95) << " / "
+        << delays.Percentile(99) << " / " << delays.Percentile(99.9) << '\n';
     out << "% Average buffer utilization: " << gs.GetAverageBufferLoad()
         << '\n';
+    if (auto graph = gs.GetTaskGraph()) {
+      double end = gs.Config.SimulationTime();
+      out << "% Completed tasks: " << graph->CompletedTasks(end) << " / "
+          << graph->TotalTasks() << '\n';
+      out << "% Makespan (cycles): " << graph->Makespan(end) << '\n';
+    }
+    if (auto multicast = gs.GetMulticast()) {
+      out << "% Multicast delivered packets: " << multicast->Delivered()
+          << '\n';
+      out << "% Multicast amplification (received/accepted flits): "
+          << gs.GetMulticastAmplification() << '\n';
+      out << "% Multicast average delivery delay (cycles): "
+          << multicast->AverageDeliveryDelay() << '\n';
+      out << "% Multicast max delivery delay (cycles): "
+          << multicast->MaxDelay() << '\n';
+    }
+    if (gs.Config.ClosedLoop()) {
+      out << "% Total transactions: " << gs.GetTransactions() << '\n';
+      out << "% Transaction throughput (transactions/cycle): "
+          << gs.GetTransactionThroughput() << '\n';
+      out << "% Average round trip delay (cycles): "
+          << gs.GetAverageRoundTripDelay() << '\n';
+      out << "% Max round trip delay (cycles): " << gs.GetMaxRoundTripDelay()
+          << '\n';
+    }
+    if (auto& flows = gs.net_.Flows) {
+      out << "% Active flows: " << flows->Active().size() << '\n';
+      out << "% Starved flows: " << flows->Starved() << '\n';
+      out << "% Flow fairness (Jain's index): " << flows->Fairness() << '\n';
+    }
     if (gs.Config.ReportFlitTrace()) {
       out << *gs.net_.Tracer;
     }
@@ -291,6 +684,15 @@ std::ostream& operator<<(std::ostream& out, const GlobalStats& gs) {
     if (gs.Config.ReportDistribution()) {
       gs.ShowDistribution(out);
     }
+    if (gs.Config.ReportLatencyBreakdown()) {
+      gs.ShowLatencyBreakdown(out);
+    }
+    if (gs.Config.ReportLinks()) {
+      gs.ShowLinks(out);
+    }
+    if (gs.Config.ReportDelayComponents()) {
+      gs.ShowDelayComponents(out);
+    }
   }
 
   return out;
@@ -7,6 +7,14 @@
 
 #include "Configuration/Configuration.hpp"
 #include "Hardware/Network.hpp"
+#include "Metrics/ResultWriter.hpp"
+#include "Metrics/TimeSeriesWriter.hpp"
+
+class TaskGraphTrafficManager;
+class MulticastTrafficManager;
+
+// Reported delay percentiles
+constexpr double DelayPercentiles[] = {50, 95, 99, 99.9};
 
 class GlobalStats : public sc_module {
   SC_HAS_PROCESS(GlobalStats);
@@ -15,6 +23,46 @@ class GlobalStats : public sc_module {
   const Configuration& Config;
   const Network& net_;
 
+  // Time series of network state, see report_cycle_result
+  std::unique_ptr<TimeSeriesWriter> Series;
+  std::size_t BufferSlots = 0;
+  TimeSeriesWriter::Sample LastSample{};
+
+  // Aggregates of all tiles collected in one pass by FinishStats, delays
+  // are sums of processor averages weighted by their packets
+  struct Totals {
+    std::size_t flits_produced = 0;
+    std::size_t flits_accepted = 0;
+    std::size_t flits_received = 0;
+    std::size_t actual_flits_accepted = 0;
+    std::size_t actual_flits_received = 0;
+    std::size_t flits_in_buffers = 0;
+    std::size_t flits_in_transmission = 0;
+    // Expected deliveries of sent flits and of flits still in network,
+    // multicast flit is delivered to each destination of its copy
+    std::size_t deliveries_sent = 0;
+    std::size_t deliveries_pending = 0;
+    std::size_t packets_received = 0;
+    std::size_t packets_dropped = 0;
+    std::size_t transactions = 0;
+    double last_received_time = 0;
+    double max_buffer_stuck_delay = -1;
+    double max_time_in_network = 0;
+    double max_delay = -1;
+    double max_round_trip = 0;
+    double delay = 0;
+    double queue_delay = 0;
+    double router_wait = 0;
+    double traversal = 0;
+    double serialization = 0;
+    double round_trip = 0;   // Weighted by transactions
+    double buffer_load = 0;  // Sum of router average loads
+    LatencyHistogram delays;
+
+    void Merge(const Totals& other);
+  };
+  mutable Totals Final;
+
   std::size_t GetActualFlitsReceived() const;
   std::size_t GetActualFlitsAccepted() const;
   std::size_t GetFlitsInBuffers() const;
@@ -36,17 +84,44 @@ class GlobalStats : public sc_module {
   std::size_t GetFlitsLost() const;
 
   double GetAverageDelay() const;
+  double GetAverageQueueDelay() const;
+  double GetAverageNetworkDelay() const;
+  // Network delay components, see report_delay_components
+  double GetAverageRouterWait() const;
+  double GetAverageTraversalDelay() const;
+  double GetAverageSerializationDelay() const;
   double GetMaxDelay() const;
+  // Merged delay histogram of all processors
+  LatencyHistogram GetDelayHistogram() const;
+  std::size_t GetPacketsDropped() const;
+
+  // Task graph traffic or nullptr
+  const TaskGraphTrafficManager* GetTaskGraph() const;
+
+  // Multicast traffic or nullptr
+  const MulticastTrafficManager* GetMulticast() const;
+  double GetMulticastAmplification() const;
+
+  std::size_t GetTransactions() const;
+  double GetTransactionThroughput() const;
+  double GetAverageRoundTripDelay() const;
+  double GetMaxRoundTripDelay() const;
 
   double GetAverageBufferLoad(std::size_t relay, std::size_t vc) const;
   double GetAverageBufferLoad() const;
 
   void ShowBuffers(std::ostream& out) const;
   void ShowDistribution(std::ostream& out) const;
+  void ShowLatencyBreakdown(std::ostream& out) const;
+  void ShowLinks(std::ostream& out) const;
+  void ShowDelayComponents(std::ostream& out) const;
 
   void Update();
 
+  // Stops stuck timers and collects end of run aggregates, which are
+  // returned by metric getters
   void FinishStats() const;
+  void WriteGlobal(ResultWriter& out) const;
 
   GlobalStats(sc_module_name name, const ::Network& network,
               const Configuration& config);
@@ -60,4 +135,7 @@ class GlobalStats : public sc_module {
 
   // Shows global statistics
   friend std::ostream& operator<<(std::ostream& out, const GlobalStats& gs);
+  // Writes configuration, runtime, global, buffer and node records to
+  // result_filename, seconds is wall time of the simulation
+  void WriteResult(double seconds) const;
 };
@@ -0,0 +1,33 @@
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+
+std::uint64_t LatencyHistogram::BucketValue(std::int32_t index) {
+  if (index < SubBuckets) return index;
+  std::int32_t shift = (index - SubBuckets) / HalfBuckets + 1;
+  std::uint64_t top = (index - SubBuckets) % HalfBuckets + HalfBuckets;
+  return ((top + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& histogram) {
+  for (std::int32_t i = 0; i < Buckets; i++) Counts[i] += histogram.Counts[i];
+  Total += histogram.Total;
+  Max = std::max(Max, histogram.Max);
+}
+void LatencyHistogram::Reset() {
+  Counts.fill(0);
+  Total = 0;
+  Max = 0;
+}
+
+double LatencyHistogram::Percentile(double percent) const {
+  if (!Total) return 0;
+  std::uint64_t rank = std::max<std::uint64_t>(
+      1, std::ceil(percent / 100 * static_cast<double>(Total)));
+  std::uint64_t count = 0;
+  for (std::int32_t i = 0; i < Buckets; i++) {
+    count += Counts[i];
+    if (count >= rank) return std::min(BucketValue(i), Max);
+  }
+  return Max;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// Fixed memory histogram of packet delays with logarithmic buckets.
+// Values below 2^SubBucketBits cycles are counted exactly, each larger
+// power of two range is split into 2^(SubBucketBits - 1) linear buckets,
+// so relative error of percentiles does not exceed 2^(1 - SubBucketBits).
+// Values not less than 2^MaxBits cycles are counted in the last bucket.
+class LatencyHistogram {
+ public:
+  static constexpr std::int32_t SubBucketBits = 7;
+  static constexpr std::int32_t MaxBits = 32;
+  static constexpr std::int32_t SubBuckets = 1 << SubBucketBits;
+  static constexpr std::int32_t HalfBuckets = SubBuckets / 2;
+  static constexpr std::int32_t Buckets =
+      SubBuckets + (MaxBits - SubBucketBits) * HalfBuckets;
+
+ private:
+  std::array<std::uint64_t, Buckets> Counts{};
+  std::uint64_t Total = 0;
+  std::uint64_t Max = 0;
+
+  static std::int32_t BucketIndex(std::uint64_t value) {
+    if (value < SubBuckets) return value;
+    if (value >> MaxBits) return Buckets - 1;
+    std::int32_t shift = 64 - __builtin_clzll(value) - SubBucketBits;
+    return SubBuckets + (shift - 1) * HalfBuckets +
+           static_cast<std::int32_t>(value >> shift) - HalfBuckets;
+  }
+  // Largest value counted in the given bucket
+  static std::uint64_t BucketValue(std::int32_t index);
+
+ public:
+  void Record(double value) {
+    std::uint64_t v = value > 0 ? std::llround(value) : 0;
+    Counts[BucketIndex(v)]++;
+    Total++;
+    if (v > Max) Max = v;
+  }
+  void Merge(const LatencyHistogram& histogram);
+  void Reset();
+
+  std::uint64_t Count() const { return Total; }
+  // Smallest value not less than the given percent of recorded values,
+  // up to bucket precision; 0 for empty histogram
+  double Percentile(double percent) const;
+};
@@ -0,0 +1,47 @@
+#include "Profiler.hpp"
+
+#include <iomanip>
+
+std::uint64_t Profiler::Ticks[Profiler::Sections];
+std::uint64_t Profiler::Calls[Profiler::Sections];
+std::uint64_t Profiler::StartTicks;
+std::chrono::steady_clock::time_point Profiler::StartTime;
+
+// Names are indented by nesting of sections
+static const char* SectionNames[Profiler::Sections] = {
+    "Router update",       "  Reservation",
+    "    Find destination", "  Route",
+    "  RX process",        "  Stats update",
+    "Processor update",    "  Traffic generation",
+    "GlobalStats update"};
+
+void Profiler::Start() {
+  for (std::int32_t s = 0; s < Sections; s++) Ticks[s] = Calls[s] = 0;
+  StartTime = std::chrono::steady_clock::now();
+  StartTicks = Now();
+}
+
+void Profiler::Report(std::ostream& out, double cycles) {
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                    StartTime)
+          .count();
+  double ticks_per_second = (Now() - StartTicks) / seconds;
+
+  // Sections at top level do not overlap, the rest is spent in the kernel
+  double measured = 0;
+  for (Section s : {RouterUpdate, ProcessorUpdate, GlobalStatsUpdate})
+    measured += Ticks[s] / ticks_per_second;
+
+  out << "% Profile (section: calls, seconds, ns/call, % of run):\n";
+  auto show = [&](const char* name, std::uint64_t calls, double time) {
+    out << "% " << std::left << std::setw(22) << name << std::right << ' '
+        << calls << ' ' << time << ' '
+        << (calls ? time * 1e9 / calls : 0) << ' ' << time * 100 / seconds
+        << '\n';
+  };
+  for (std::int32_t s = 0; s < Sections; s++)
+    show(SectionNames[s], Calls[s], Ticks[s] / ticks_per_second);
+  show("Kernel and other", 0, seconds - measured);
+  out << "% Simulation speed (cycles/s): " << cycles / seconds << '\n';
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Self-profiling of simulator phases. Scoped timers accumulate ticks and
+// calls of each section; they are compiled only with NEWXIM_PROFILE defined
+// (cmake -DNEWXIM_PROFILE=ON), otherwise PROFILE_SCOPE expands to nothing.
+// Ticks are read with rdtsc on x86 and converted to seconds by calibration
+// against steady_clock over the whole run, other platforms use steady_clock.
+class Profiler {
+ public:
+  enum Section : std::int32_t {
+    RouterUpdate,
+    Reservation,
+    FindDestination,
+    Route,
+    RXProcess,
+    StatsUpdate,
+    ProcessorUpdate,
+    TrafficGeneration,
+    GlobalStatsUpdate,
+    Sections
+  };
+
+  class Scope {
+    const Section section;
+    const std::uint64_t start;
+
+   public:
+    explicit Scope(Section s) : section(s), start(Now()) {}
+    ~Scope() { Record(section, Now() - start); }
+  };
+
+  static std::uint64_t Now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+  }
+  static void Record(Section section, std::uint64_t ticks) {
+    Ticks[section] += ticks;
+    Calls[section]++;
+  }
+
+  // Starts calibration and wall clock of the profiled run
+  static void Start();
+  // Shows breakdown of sections and simulation speed
+  static void Report(std::ostream& out, double cycles);
+
+ private:
+  static std::uint64_t Ticks[Sections];
+  static std::uint64_t Calls[Sections];
+  static std::uint64_t StartTicks;
+  static std::chrono::steady_clock::time_point StartTime;
+};
+
+#ifdef NEWXIM_PROFILE
+#define PROFILE_SCOPE(section) \
+  Profiler::Scope profiler_scope(Profiler::section)
+#else
+#define PROFILE_SCOPE(section)
+#endif
@@ -0,0 +1,110 @@
+#include "ResultWriter.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+ResultWriter::ResultWriter(const std::string& file, Format format)
+    : File(file, std::ios::out | std::ios::binary), Type(format) {
+  if (!File)
+    throw std::runtime_error("ResultWriter error: Can not open file [" + file +
+                             "].");
+  Data.reserve(ChunkSize + 4096);
+  if (Type == Format::Csv) Append("type,node,port,vc,name,value\n");
+}
+ResultWriter::~ResultWriter() { Flush(); }
+
+void ResultWriter::Flush() {
+  File.write(Data.data(), Data.size());
+  Data.clear();
+}
+
+void ResultWriter::AppendNumber(std::int64_t value) {
+  char buffer[24];
+  auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  Data.insert(Data.end(), buffer, result.ptr);
+}
+void ResultWriter::AppendNumber(double value) {
+  // Undefined averages are written as null in JSON and empty in CSV
+  if (!std::isfinite(value)) {
+    if (Type == Format::JsonLines) Append("null");
+    return;
+  }
+  char buffer[32];
+  auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  Data.insert(Data.end(), buffer, result.ptr);
+}
+void ResultWriter::AppendString(std::string_view value) {
+  if (Type == Format::JsonLines) {
+    Append('"');
+    for (char c : value) {
+      if (c == '"' || c == '\\') {
+        Append('\\');
+        Append(c);
+      } else if (c == '\n') {
+        Append("\\n");
+      } else {
+        Append(c);
+      }
+    }
+    Append('"');
+  } else if (value.find_first_of(",\"\n") != std::string_view::npos) {
+    Append('"');
+    for (char c : value) {
+      if (c == '"') Append('"');
+      Append(c);
+    }
+    Append('"');
+  } else {
+    Append(value);
+  }
+}
+
+void ResultWriter::Begin(std::string_view type, std::int64_t node,
+                         std::int64_t port, std::int64_t vc) {
+  if (Type == Format::JsonLines) {
+    Append("{\"type\":\"");
+    Append(type);
+    Append('"');
+    if (node >= 0) Field("node", node);
+    if (port >= 0) Field("port", port);
+    if (vc >= 0) Field("vc", vc);
+    return;
+  }
+  Prefix.assign(type);
+  for (std::int64_t key : {node, port, vc}) {
+    Prefix += ',';
+    if (key >= 0) Prefix += std::to_string(key);
+  }
+  Prefix += ',';
+}
+void ResultWriter::Name(std::string_view name) {
+  if (Type == Format::JsonLines) {
+    Append(",\"");
+    Append(name);
+    Append("\":");
+  } else {
+    Append(Prefix);
+    Append(name);
+    Append(',');
+  }
+}
+void ResultWriter::Field(std::string_view name, std::int64_t value) {
+  Name(name);
+  AppendNumber(value);
+  if (Type == Format::Csv) Append('\n');
+}
+void ResultWriter::Field(std::string_view name, double value) {
+  Name(name);
+  AppendNumber(value);
+  if (Type == Format::Csv) Append('\n');
+}
+void ResultWriter::Field(std::string_view name, std::string_view value) {
+  Name(name);
+  AppendString(value);
+  if (Type == Format::Csv) Append('\n');
+}
+void ResultWriter::End() {
+  if (Type == Format::JsonLines) Append("}\n");
+  if (Data.size() >= ChunkSize) Flush();
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Writes records of simulation result in JSON lines or CSV format. Each
+// JSON line is an object with "type" of the record and its fields. CSV file
+// has one row per field: type,node,port,vc,name,value. Values are formatted
+// with std::to_chars into a memory buffer, which goes to the file in large
+// chunks, so even millions of fields are written in milliseconds.
+class ResultWriter {
+ public:
+  enum class Format { JsonLines, Csv };
+
+ private:
+  static constexpr std::size_t ChunkSize = 1 << 20;
+
+  std::ofstream File;
+  const Format Type;
+  std::vector<char> Data;
+  // Prefix of each CSV row of the current record
+  std::string Prefix;
+
+  void Append(std::string_view text) {
+    Data.insert(Data.end(), text.begin(), text.end());
+  }
+  void Append(char c) { Data.push_back(c); }
+  void AppendNumber(std::int64_t value);
+  void AppendNumber(double value);
+  void AppendString(std::string_view value);
+  void Name(std::string_view name);
+  void Flush();
+
+ public:
+  ResultWriter(const std::string& file, Format format);
+  ~ResultWriter();
+
+  // Starts new record, negative node, port and vc are omitted
+  void Begin(std::string_view type, std::int64_t node = -1,
+             std::int64_t port = -1, std::int64_t vc = -1);
+  void Field(std::string_view name, std::int64_t value);
+  void Field(std::string_view name, std::uint64_t value) {
+    Field(name, static_cast<std::int64_t>(value));
+  }
+  void Field(std::string_view name, std::int32_t value) {
+    Field(name, static_cast<std::int64_t>(value));
+  }
+  void Field(std::string_view name, double value);
+  void Field(std::string_view name, std::string_view value);
+  void End();
+};
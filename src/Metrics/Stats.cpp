@@ -33,6 +33,13 @@ void Stats::PushLoad(std::int32_t relay, std::int32_t vc, double load) {
   stats.total_load += load;
 }
 
+void Stats::SetLinks(std::size_t ports, std::size_t vcs) {
+  link_vcs = vcs;
+  link_traversals.assign(ports * vcs, 0);
+  link_blocked.assign(ports * vcs, 0);
+  link_credit_stalls.assign(ports * vcs, 0);
+}
+
 double Stats::GetMaxBufferStuckDelay(std::int32_t relay, std::int32_t vc) {
   auto it = Buffers.find({relay, vc});
 
@@ -83,3 +90,16 @@ double Stats::GetAverageBufferLoad() const {
   }
 }
 std::int32_t Stats::GetFlitsRouted() const { return flits_routed; }
+std::uint64_t Stats::GetHeadsRouted() const { return heads_routed; }
+double Stats::GetTotalHeadWait() const { return head_wait; }
+std::uint64_t Stats::GetLinkTraversals(std::int32_t port,
+                                       std::int32_t vc) const {
+  return link_traversals[port * link_vcs + vc];
+}
+std::uint64_t Stats::GetLinkBlocked(std::int32_t port, std::int32_t vc) const {
+  return link_blocked[port * link_vcs + vc];
+}
+std::uint64_t Stats::GetLinkCreditStalls(std::int32_t port,
+                                         std::int32_t vc) const {
+  return link_credit_stalls[port * link_vcs + vc];
+}
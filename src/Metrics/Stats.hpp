@@ -1,5 +1,6 @@
 #pragma once
 #include <map>
+#include <vector>
 
 #include "Data/Flit.hpp"
 #include "Hardware/Connection.hpp"
@@ -17,22 +18,60 @@ class Stats {
  private:
   std::map<Connection, BufferStats> Buffers;
   std::int32_t flits_routed;
+  // Queueing of head flits beyond forwarding cycle
+  double head_wait = 0;
+  std::uint64_t heads_routed = 0;
+
+  // Output link counters by port * link_vcs + vc
+  std::size_t link_vcs = 0;
+  std::vector<std::uint64_t> link_traversals;
+  std::vector<std::uint64_t> link_blocked;
+  std::vector<std::uint64_t> link_credit_stalls;
 
  public:
   const SimulationTimer Timer;
   Stats(const SimulationTimer& timer);
 
   void FlitRouted(const Flit& flit);
+  void FlitWaited(const Flit& flit, double wait) {
+    if (HasFlag(flit.flit_type, FlitType::Head) &&
+        Timer.StatisticsTime() >= 0) {
+      head_wait += wait;
+      heads_routed++;
+    }
+  }
   void FlitReceived(std::int32_t relay, std::int32_t vc);
 
   void StartStuckTimer(std::int32_t relay, std::int32_t vc);
   void StopStuckTimer(std::int32_t relay, std::int32_t vc);
   void PushLoad(std::int32_t relay, std::int32_t vc, double load);
 
+  void SetLinks(std::size_t ports, std::size_t vcs);
+  // Flit was sent to output
+  void LinkTraversed(std::int32_t port, std::int32_t vc) {
+    if (Timer.StatisticsTime() >= 0) link_traversals[port * link_vcs + vc]++;
+  }
+  // Flit waiting for output was not sent, because the output was held by
+  // another packet or the link was busy
+  void LinkBlocked(std::int32_t port, std::int32_t vc) {
+    if (Timer.StatisticsTime() >= 0) link_blocked[port * link_vcs + vc]++;
+  }
+  // Flit waiting for output was not sent due to lack of free slots in the
+  // next buffer
+  void LinkCreditStall(std::int32_t port, std::int32_t vc) {
+    if (Timer.StatisticsTime() >= 0)
+      link_credit_stalls[port * link_vcs + vc]++;
+  }
+
   double GetMaxBufferStuckDelay(std::int32_t relay, std::int32_t vc);
   std::int32_t GetBufferFlitsReceived(std::int32_t relay, std::int32_t vc);
   double GetMaxBufferStuckDelay();
   double GetAverageBufferLoad(std::int32_t relay, std::int32_t vc) const;
   double GetAverageBufferLoad() const;
   std::int32_t GetFlitsRouted() const;
+  std::uint64_t GetHeadsRouted() const;
+  double GetTotalHeadWait() const;
+  std::uint64_t GetLinkTraversals(std::int32_t port, std::int32_t vc) const;
+  std::uint64_t GetLinkBlocked(std::int32_t port, std::int32_t vc) const;
+  std::uint64_t GetLinkCreditStalls(std::int32_t port, std::int32_t vc) const;
 };
@@ -0,0 +1,78 @@
+#include "TimeSeriesWriter.hpp"
+
+#include <stdexcept>
+
+TimeSeriesWriter::TimeSeriesWriter(const std::string& file, bool binary)
+    : File(file, binary ? std::ios::out | std::ios::binary : std::ios::out),
+      Binary(binary) {
+  if (!File)
+    throw std::runtime_error("TimeSeriesWriter error: Can not open file [" +
+                             file + "].");
+  if (Binary) {
+    File.write("NXSERIES", 8);
+  } else {
+    File << "cycle,injected,accepted,received,buffered,in_flight,occupancy\n";
+  }
+  Block.reserve(BlockSize);
+  Writer = std::thread(&TimeSeriesWriter::Run, this);
+}
+TimeSeriesWriter::~TimeSeriesWriter() {
+  {
+    std::lock_guard<std::mutex> lock(Mutex);
+    if (!Block.empty()) Full.push_back(std::move(Block));
+    Finished = true;
+  }
+  Ready.notify_one();
+  Writer.join();
+}
+
+void TimeSeriesWriter::Push(const Sample& sample) {
+  Block.push_back(sample);
+  if (Block.size() < BlockSize) return;
+
+  {
+    std::lock_guard<std::mutex> lock(Mutex);
+    Full.push_back(std::move(Block));
+    if (!Empty.empty()) {
+      Block = std::move(Empty.back());
+      Empty.pop_back();
+    } else {
+      Block = std::vector<Sample>();
+    }
+  }
+  Ready.notify_one();
+  Block.reserve(BlockSize);
+}
+
+void TimeSeriesWriter::Run() {
+  std::vector<std::vector<Sample>> blocks;
+  std::unique_lock<std::mutex> lock(Mutex);
+  while (true) {
+    Ready.wait(lock, [this] { return Finished || !Full.empty(); });
+    if (Full.empty()) break;
+    blocks.swap(Full);
+    lock.unlock();
+
+    for (auto& block : blocks) {
+      Write(block);
+      block.clear();
+    }
+    File.flush();
+
+    lock.lock();
+    for (auto& block : blocks) Empty.push_back(std::move(block));
+    blocks.clear();
+  }
+}
+void TimeSeriesWriter::Write(const std::vector<Sample>& samples) {
+  if (Binary) {
+    File.write(reinterpret_cast<const char*>(samples.data()),
+               samples.size() * sizeof(Sample));
+    return;
+  }
+  for (const Sample& s : samples) {
+    File << s.cycle << ',' << s.injected << ',' << s.accepted << ','
+         << s.received << ',' << s.buffered << ',' << s.in_flight << ','
+         << s.occupancy << '\n';
+  }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Writes time series samples to file in background thread. Samples are
+// collected in fixed size blocks, full blocks are handed over to the writer
+// thread and returned back empty, so simulation thread never waits for file
+// I/O and does not allocate after the first blocks.
+class TimeSeriesWriter {
+ public:
+  struct Sample {
+    std::uint64_t cycle;
+    std::uint64_t injected;  // Flits during the period ending at cycle
+    std::uint64_t accepted;
+    std::uint64_t received;
+    std::uint64_t buffered;  // Flits in router buffers at cycle
+    std::int64_t in_flight;  // Packets injected but not received yet
+    double occupancy;        // Share of occupied router buffer slots
+  };
+
+ private:
+  static constexpr std::size_t BlockSize = 4096;
+
+  std::ofstream File;
+  const bool Binary;
+
+  std::vector<Sample> Block;  // Filled by simulation thread
+  std::mutex Mutex;
+  std::condition_variable Ready;
+  std::vector<std::vector<Sample>> Full;   // Guarded by Mutex
+  std::vector<std::vector<Sample>> Empty;  // Guarded by Mutex
+  bool Finished = false;                   // Guarded by Mutex
+  std::thread Writer;
+
+  void Run();
+  void Write(const std::vector<Sample>& samples);
+
+ public:
+  TimeSeriesWriter(const std::string& file, bool binary);
+  ~TimeSeriesWriter();
+
+  void Push(const Sample& sample);
+};
@@ -0,0 +1,282 @@
+#include "ChannelDependencyGraph.hpp"
+
+#include <algorithm>
+
+#include "Hardware/Tile.hpp"
+#include "Routing/RoutingAlgorithm.hpp"
+#include "Selection/SelectionStrategy.hpp"
+
+ChannelDependencyGraph::ChannelDependencyGraph(const Graph& g, std::size_t v)
+    : graph(g), vcs(v), offsets(g.size() + 1, 0) {
+  for (std::size_t n = 0; n < graph.size(); n++) {
+    offsets[n + 1] = offsets[n] + (graph[n].size() + 1) * vcs;
+  }
+  dependencies.resize(offsets.back());
+  owners.resize(offsets.back());
+  for (std::size_t n = 0; n < graph.size(); n++) {
+    std::fill(owners.begin() + offsets[n], owners.begin() + offsets[n + 1], n);
+  }
+
+  peers.resize(offsets.back() / vcs, Graph::EmptyLink);
+  for (std::int32_t n = 0; n < graph.size(); n++) {
+    for (std::int32_t port = 0; port < graph[n].size(); port++) {
+      peers[offsets[n] / vcs + port] = graph.back_link(n, port);
+    }
+  }
+}
+
+std::int32_t ChannelDependencyGraph::ChannelIndex(std::int32_t node,
+                                                  std::int32_t port,
+                                                  std::int32_t vc) const {
+  return offsets[node] + port * vcs + vc;
+}
+ChannelDependencyGraph::Channel ChannelDependencyGraph::ChannelAt(
+    std::int32_t index) const {
+  std::int32_t node = owners[index];
+  std::int32_t local = index - offsets[node];
+  return {node,
+          {static_cast<std::int32_t>(local / vcs),
+           static_cast<std::int32_t>(local % vcs)}};
+}
+void ChannelDependencyGraph::AddDependency(std::int32_t from, std::int32_t to) {
+  auto& list = dependencies[from];
+  if (std::find(list.begin(), list.end(), to) == list.end()) {
+    list.push_back(to);
+    total_dependencies++;
+  }
+}
+
+void ChannelDependencyGraph::Build(const std::vector<Tile>& tiles,
+                                   const RoutingAlgorithm& routing,
+                                   const SelectionStrategy& selection,
+                                   std::int32_t packet_size) {
+  std::vector<std::uint32_t> visited(Channels(), 0);
+  std::uint32_t stamp = 0;
+  std::vector<std::int32_t> queue;
+  std::vector<Connection> candidates;
+  std::vector<Connection> single(1);
+
+  for (std::int32_t src = 0; src < graph.size(); src++) {
+    for (std::int32_t dst = 0; dst < graph.size(); dst++) {
+      if (src == dst) continue;
+
+      // Packets are injected through local relay on virtual channel 0
+      stamp++;
+      queue.clear();
+      queue.push_back(ChannelIndex(src, graph[src].size(), 0));
+      visited[queue.front()] = stamp;
+
+      for (std::size_t i = 0; i < queue.size(); i++) {
+        Channel channel = ChannelAt(queue[i]);
+        if (channel.node == dst) continue;
+
+        const auto& node = graph[channel.node];
+        const Router& router = *tiles[channel.node].RouterDevice;
+
+        Flit flit;
+        flit.id = 0;
+        flit.src_id = src;
+        flit.dst_id = dst;
+        flit.port_in = channel.con.port;
+        flit.port_out = channel.con.port < node.size()
+                            ? peers[offsets[channel.node] / vcs +
+                                    channel.con.port]
+                            : -1;
+        flit.vc_id = channel.con.vc;
+        flit.flit_type = FlitType::Head;
+        flit.sequence_no = 0;
+        flit.sequence_length = packet_size;
+        flit.timestamp = 0;
+        flit.accept_timestamp = 0;
+        flit.hop_no = 0;
+
+        candidates.clear();
+        routing.Route(router, flit, candidates);
+
+        // Selection is probed for each candidate separately, so every
+        // choice it could make under some network state is taken into account
+        for (Connection candidate : candidates) {
+          single[0] = candidate;
+          Connection con = selection.Apply(router, flit, single);
+          if (!con.valid() || con.port >= node.size() || con.vc >= vcs)
+            continue;
+
+          std::int32_t peer = peers[offsets[channel.node] / vcs + con.port];
+          if (peer < 0) continue;
+
+          std::int32_t next = ChannelIndex(node[con.port], peer, con.vc);
+          AddDependency(queue[i], next);
+          if (visited[next] != stamp) {
+            visited[next] = stamp;
+            queue.push_back(next);
+          }
+        }
+      }
+    }
+  }
+}
+
+void ChannelDependencyGraph::Snapshot(const std::vector<Tile>& tiles,
+                                      const RoutingAlgorithm& routing) {
+  std::vector<Connection> candidates;
+
+  for (std::int32_t n = 0; n < graph.size(); n++) {
+    const auto& node = graph[n];
+    const Router& router = *tiles[n].RouterDevice;
+    const auto& table = router.GetReservationTable();
+
+    for (std::int32_t port = 0; port < router.Size(); port++) {
+      for (std::int32_t vc = 0; vc < router[port].Size(); vc++) {
+        const Buffer& buffer = router[port][vc];
+        if (buffer.Empty()) continue;
+
+        std::int32_t from = ChannelIndex(n, port, vc);
+        Connection out = table[{port, vc}];
+        if (out.valid()) {
+          // Packet holds output and waits for the downstream buffer
+          if (out.port >= node.size()) continue;
+          std::int32_t peer = peers[offsets[n] / vcs + out.port];
+          if (peer < 0) continue;
+
+          const Router& next = *tiles[node[out.port]].RouterDevice;
+          if (!next[peer][out.vc].Empty()) {
+            AddDependency(from, ChannelIndex(node[out.port], peer, out.vc));
+          }
+        } else {
+          // Head flit waits for outputs held by other packets
+          Flit flit = buffer.Front();
+          if (!HasFlag(flit.flit_type, FlitType::Head)) continue;
+
+          candidates.clear();
+          routing.Route(router, flit, candidates);
+          for (Connection candidate : candidates) {
+            for (std::int32_t out_vc = 0; out_vc < vcs; out_vc++) {
+              Connection src = table.Source({candidate.port, out_vc});
+              if (src.valid() && src != Connection{port, vc}) {
+                AddDependency(from, ChannelIndex(n, src.port, src.vc));
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+std::vector<std::vector<std::int32_t>>
+ChannelDependencyGraph::CyclicComponents() const {
+  const std::int32_t count = Channels();
+  std::vector<std::int32_t> index(count, -1);
+  std::vector<std::int32_t> low(count, 0);
+  std::vector<bool> on_stack(count, false);
+  std::vector<std::int32_t> stack;
+  std::vector<std::pair<std::int32_t, std::size_t>> calls;
+  std::int32_t counter = 0;
+
+  std::vector<std::vector<std::int32_t>> result;
+  for (std::int32_t root = 0; root < count; root++) {
+    if (index[root] >= 0) continue;
+
+    index[root] = low[root] = counter++;
+    stack.push_back(root);
+    on_stack[root] = true;
+    calls.push_back({root, 0});
+
+    // Iterative Tarjan, recursion would overflow on large networks
+    while (!calls.empty()) {
+      std::int32_t v = calls.back().first;
+      std::size_t& i = calls.back().second;
+
+      if (i < dependencies[v].size()) {
+        std::int32_t w = dependencies[v][i++];
+        if (index[w] < 0) {
+          index[w] = low[w] = counter++;
+          stack.push_back(w);
+          on_stack[w] = true;
+          calls.push_back({w, 0});
+        } else if (on_stack[w]) {
+          low[v] = std::min(low[v], index[w]);
+        }
+        continue;
+      }
+
+      if (low[v] == index[v]) {
+        std::vector<std::int32_t> component;
+        std::int32_t w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          on_stack[w] = false;
+          component.push_back(w);
+        } while (w != v);
+
+        const auto& deps = dependencies[v];
+        if (component.size() > 1 ||
+            std::find(deps.begin(), deps.end(), v) != deps.end()) {
+          result.push_back(std::move(component));
+        }
+      }
+
+      calls.pop_back();
+      if (!calls.empty()) {
+        std::int32_t parent = calls.back().first;
+        low[parent] = std::min(low[parent], low[v]);
+      }
+    }
+  }
+
+  return result;
+}
+
+std::vector<std::int32_t> ChannelDependencyGraph::FindCycle(
+    const std::vector<std::int32_t>& component) const {
+  std::vector<std::int32_t> sorted = component;
+  std::sort(sorted.begin(), sorted.end());
+  auto contains = [&sorted](std::int32_t c) {
+    return std::binary_search(sorted.begin(), sorted.end(), c);
+  };
+
+  // Shortest cycle through the first channel of the component
+  const std::int32_t start = component.front();
+  std::vector<std::int32_t> parent(sorted.size(), -1);
+  auto slot = [&sorted](std::int32_t c) {
+    return std::lower_bound(sorted.begin(), sorted.end(), c) - sorted.begin();
+  };
+
+  std::vector<std::int32_t> queue(1, start);
+  for (std::size_t i = 0; i < queue.size(); i++) {
+    std::int32_t v = queue[i];
+    for (std::int32_t w : dependencies[v]) {
+      if (w == start) {
+        std::vector<std::int32_t> cycle;
+        for (std::int32_t c = v; c != start; c = parent[slot(c)])
+          cycle.push_back(c);
+        cycle.push_back(start);
+        std::reverse(cycle.begin(), cycle.end());
+        return cycle;
+      }
+      if (contains(w) && parent[slot(w)] < 0) {
+        parent[slot(w)] = v;
+        queue.push_back(w);
+      }
+    }
+  }
+
+  return component;
+}
+
+std::vector<std::vector<ChannelDependencyGraph::Channel>>
+ChannelDependencyGraph::Cycles() const {
+  std::vector<std::vector<Channel>> result;
+  for (const auto& component : CyclicComponents()) {
+    std::vector<Channel> cycle;
+    for (std::int32_t c : FindCycle(component)) cycle.push_back(ChannelAt(c));
+    result.push_back(std::move(cycle));
+  }
+  return result;
+}
+
+std::ostream& operator<<(std::ostream& os,
+                         const ChannelDependencyGraph::Channel& channel) {
+  return os << '[' << channel.node << ']' << channel.con;
+}
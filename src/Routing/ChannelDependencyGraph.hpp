@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "Configuration/Graph/Graph.hpp"
+#include "Hardware/Connection.hpp"
+
+class Tile;
+class RoutingAlgorithm;
+class SelectionStrategy;
+
+// Channel dependency graph over router input buffers (port, vc).
+// Build collects static dependencies by probing routing algorithm and
+// selection strategy for every (source, destination) pair, so only channels
+// which can actually be occupied by a packet of given destination are
+// considered. Snapshot collects wait-for dependencies between currently
+// occupied buffers instead.
+class ChannelDependencyGraph {
+ public:
+  struct Channel {
+    std::int32_t node;
+    Connection con;
+  };
+
+ private:
+  const Graph& graph;
+  const std::size_t vcs;
+
+  std::vector<std::int32_t> offsets;  // First channel index of each node
+  std::vector<std::int32_t> owners;   // Node of each channel
+  std::vector<std::int32_t> peers;    // Input port at neighbour for each link
+  std::vector<std::vector<std::int32_t>> dependencies;
+  std::size_t total_dependencies = 0;
+
+  std::int32_t ChannelIndex(std::int32_t node, std::int32_t port,
+                            std::int32_t vc) const;
+  Channel ChannelAt(std::int32_t index) const;
+  void AddDependency(std::int32_t from, std::int32_t to);
+
+  std::vector<std::int32_t> FindCycle(
+      const std::vector<std::int32_t>& component) const;
+
+ public:
+  ChannelDependencyGraph(const Graph& graph, std::size_t vcs);
+
+  void Build(const std::vector<Tile>& tiles, const RoutingAlgorithm& routing,
+             const SelectionStrategy& selection, std::int32_t packet_size);
+  void Snapshot(const std::vector<Tile>& tiles,
+                const RoutingAlgorithm& routing);
+
+  std::size_t Channels() const { return dependencies.size(); }
+  std::size_t Dependencies() const { return total_dependencies; }
+
+  // Strongly connected components with at least one cycle (Tarjan)
+  std::vector<std::vector<std::int32_t>> CyclicComponents() const;
+  // One cyclic channel chain for each cyclic component
+  std::vector<std::vector<Channel>> Cycles() const;
+
+  friend std::ostream& operator<<(std::ostream& os, const Channel& channel);
+};
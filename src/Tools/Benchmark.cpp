@@ -0,0 +1,212 @@
+// Microbenchmarks of simulator hot paths, reported in nanoseconds per
+// operation. Network is built from the usual configuration file and command
+// line overrides, so routing, selection and traffic kernels are measured
+// for the configured topology:
+//   newxim_bench -config config.yml [-routing_algorithm MESH_WEST_FIRST]
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Configuration/Configuration.hpp"
+#include "Hardware/Buffer.hpp"
+#include "Hardware/Network.hpp"
+#include "Hardware/ReservationTable.hpp"
+#include "Hardware/SimulationTimer.hpp"
+#include "Routing/RoutingAlgorithm.hpp"
+#include "Selection/SelectionStrategy.hpp"
+
+// Each benchmark is repeated at least for this time
+constexpr double MinSeconds = 0.2;
+// Results are accumulated here, so measured calls are not optimized out
+static volatile std::uint64_t Sink;
+
+// Body performs ops operations per call
+template <typename Body>
+static void Measure(const std::string& name, std::size_t ops, Body body) {
+  using clock = std::chrono::steady_clock;
+  body();
+  std::size_t calls = 0;
+  double seconds = 0;
+  auto start = clock::now();
+  do {
+    body();
+    calls++;
+    seconds = std::chrono::duration<double>(clock::now() - start).count();
+  } while (seconds < MinSeconds);
+  std::cout << "% " << std::left << std::setw(48) << name + ':' << std::right
+            << seconds * 1e9 / (calls * ops) << " ns/op\n";
+}
+
+static void BenchBuffer(std::size_t depth) {
+  Buffer buffer;
+  buffer.Reserve(depth);
+  Flit flit;
+  flit.flit_type = FlitType::Head;
+  Measure("Buffer push/pop (depth " + std::to_string(depth) + ")",
+          256 * depth, [&] {
+            for (std::size_t r = 0; r < 256; r++) {
+              for (std::size_t i = 0; i < depth; i++) buffer.Push(flit);
+              for (std::size_t i = 0; i < depth; i++)
+                Sink += buffer.Pop().flit_type == FlitType::Head;
+            }
+          });
+}
+
+// Each input of router with the given radix holds output of the next port
+static void BenchReservationTable(std::int32_t radix, std::int32_t vcs) {
+  std::string suffix = " (radix " + std::to_string(radix) + ")";
+  ReservationTable table;
+  Measure("ReservationTable reserve/release" + suffix, 2 * radix * vcs, [&] {
+    for (std::int32_t p = 0; p < radix; p++) {
+      for (std::int32_t vc = 0; vc < vcs; vc++)
+        table.Reserve({p, vc}, {(p + 1) % radix, vc});
+    }
+    for (std::int32_t p = 0; p < radix; p++) {
+      for (std::int32_t vc = 0; vc < vcs; vc++) table.Release({p, vc});
+    }
+  });
+
+  for (std::int32_t p = 0; p < radix; p += 2) {
+    for (std::int32_t vc = 0; vc < vcs; vc++)
+      table.Reserve({p, vc}, {(p + 1) % radix, vc});
+  }
+  Measure("ReservationTable lookup" + suffix, 2 * radix * vcs, [&] {
+    for (std::int32_t p = 0; p < radix; p++) {
+      for (std::int32_t vc = 0; vc < vcs; vc++) {
+        Sink += table[{p, vc}].valid();
+        Sink += table.Reserved({p, vc});
+      }
+    }
+  });
+}
+
+struct Probe {
+  const Router* router;
+  Flit flit;
+  std::vector<Connection> candidates;
+};
+
+// Probes are taken along routes of packets between sampled pairs of nodes,
+// so each of them has input and output ports the router would see
+static std::vector<Probe> CollectProbes(const Network& net,
+                                        const Graph& graph) {
+  const RoutingAlgorithm& routing = net.GetRoutingAlgorithm();
+  const SelectionStrategy& selection = net.GetSelectionStrategy();
+  std::vector<Probe> probes;
+  std::size_t pairs = graph.size() * (graph.size() - 1);
+  std::size_t step = pairs > 4096 ? pairs / 4096 : 1;
+  for (std::size_t pair = 0; pair < pairs; pair += step) {
+    std::int32_t src = pair / (graph.size() - 1);
+    std::int32_t dst = pair % (graph.size() - 1);
+    if (dst >= src) dst++;
+
+    Flit flit;
+    flit.id = pair;
+    flit.src_id = src;
+    flit.dst_id = dst;
+    flit.port_in = graph[src].size();
+    flit.vc_id = 0;
+    flit.flit_type = FlitType::Head;
+    flit.sequence_no = 0;
+    flit.sequence_length = 1;
+    flit.timestamp = 0;
+    flit.hop_no = 0;
+    for (std::int32_t node = src; node != dst && flit.hop_no < graph.size();
+         flit.hop_no++) {
+      Probe probe{net.Tiles[node].RouterDevice.get(), flit, {}};
+      routing.Route(*probe.router, flit, probe.candidates);
+      Connection con = selection.Apply(*probe.router, flit, probe.candidates);
+      probes.push_back(std::move(probe));
+      if (!con.valid() || con.port >= graph[node].size() ||
+          graph[node][con.port] == Graph::EmptyLink)
+        break;
+
+      std::int32_t next = graph[node][con.port];
+      flit.port_out = con.port;
+      flit.port_in = graph[next].links_to(node).front();
+      flit.vc_id = con.vc;
+      node = next;
+    }
+  }
+  return probes;
+}
+
+int sc_main(int arg_num, char* arg_vet[]) {
+  try {
+    Configuration config(arg_num, arg_vet);
+    SimulationTimer timer(config.ClockPeriodPS(), config.ResetTime(),
+                          config.StatsWarmUpTime(), config.SimulationTime(),
+                          config.ProductionTime());
+    Network net(config, timer);
+    // Relays report free slots of their neighbours only after reset
+    net.reset.write(true);
+    sc_start(config.ResetTime(), SC_NS);
+    net.reset.write(false);
+
+    std::cout << "% Routing: " << config.RoutingAlgorithm()
+              << ", selection: " << config.SelectionStrategy()
+              << ", nodes: " << net.Tiles.size() << '\n';
+
+    for (std::size_t depth : {4, 16, 64}) BenchBuffer(depth);
+    for (std::int32_t radix : {5, 9, 17, 33, 65})
+      BenchReservationTable(radix, config.VirtualChannels());
+
+    const Router& router = *net.Tiles.front().RouterDevice;
+    std::size_t channels = router.Size() * config.VirtualChannels();
+    Measure("Relay CanSend/GetFreeSlots", 2 * channels, [&] {
+      for (std::size_t p = 0; p < router.Size(); p++) {
+        for (std::size_t vc = 0; vc < router[p].Size(); vc++)
+          Sink += router[p].CanSend(vc) + router[p].GetFreeSlots(vc);
+      }
+    });
+
+    std::vector<Probe> probes = CollectProbes(net, config.NetworkGraph());
+    std::vector<Connection> candidates;
+    const RoutingAlgorithm& routing = net.GetRoutingAlgorithm();
+    Measure("RoutingAlgorithm::Route", probes.size(), [&] {
+      for (const Probe& probe : probes) {
+        candidates.clear();
+        routing.Route(*probe.router, probe.flit, candidates);
+        Sink += candidates.size();
+      }
+    });
+    const SelectionStrategy& selection = net.GetSelectionStrategy();
+    Measure("SelectionStrategy::Apply", probes.size(), [&] {
+      for (const Probe& probe : probes) {
+        Sink += selection.Apply(*probe.router, probe.flit, probe.candidates)
+                    .port;
+      }
+    });
+
+    const Graph& graph = config.NetworkGraph();
+    std::size_t links = 0;
+    for (const auto& node : graph) {
+      for (std::int32_t neighbour : node)
+        links += neighbour != Graph::EmptyLink;
+    }
+    Measure("GraphNode::links_to", links, [&] {
+      for (std::int32_t id = 0; id < graph.size(); id++) {
+        for (std::int32_t neighbour : graph[id]) {
+          if (neighbour != Graph::EmptyLink)
+            Sink += graph[neighbour].links_to(id).size();
+        }
+      }
+    });
+
+    const TrafficManager& traffic = net.GetTrafficManager();
+    double time = config.ResetTime();
+    Measure("TrafficManager::FirePacket", 64 * net.Tiles.size(), [&] {
+      for (std::int32_t cycle = 0; cycle < 64; cycle++, time++) {
+        for (std::int32_t id = 0; id < net.Tiles.size(); id++)
+          Sink += traffic.FirePacket(id, time);
+      }
+    });
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cout << "Error: " << ex.what() << '\n';
+    return 1;
+  }
+}
@@ -0,0 +1,232 @@
+// Performance regression harness. Runs simulator for each case of the cases
+// file, measures simulated cycles per second, peak resident memory and
+// startup time, and compares them with the stored baseline:
+//   newxim_regress [-simulator ./newxim] [-cases benchmarks/cases.txt]
+//                  [-baseline baseline.csv] [-save baseline.csv]
+//                  [-threshold 10] [-repeat 1] [-filter substring]
+// Results are printed as CSV, exit code is 1 if any case regressed or failed.
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct Case {
+  std::string name;
+  std::vector<std::string> args;
+};
+
+struct Result {
+  double cycles_per_second = 0;
+  long peak_rss_kb = 0;
+  double startup_seconds = 0;
+};
+
+// Startup time differences below this are considered as timer noise
+constexpr double StartupSlack = 0.05;
+
+// Each line is case name, configuration file relative to the cases file and
+// command line overrides, lines starting with '%' are comments
+static std::vector<Case> LoadCases(const std::string& file) {
+  std::ifstream fin(file);
+  if (!fin)
+    throw std::runtime_error("Regression error: File [" + file +
+                             "] does not exist.");
+  std::string dir = file.substr(0, file.find_last_of('/') + 1);
+
+  std::vector<Case> cases;
+  std::string line;
+  for (std::size_t number = 1; std::getline(fin, line); number++) {
+    std::istringstream stream(line);
+    Case c;
+    std::string config;
+    if (!(stream >> c.name) || c.name[0] == '%') continue;
+    if (!(stream >> config))
+      throw std::runtime_error("Regression error: Invalid line [" +
+                               std::to_string(number) + "] in file [" + file +
+                               "].");
+    c.args = {"-config", dir + config};
+    for (std::string arg; stream >> arg;) c.args.push_back(arg);
+    cases.push_back(c);
+  }
+  return cases;
+}
+
+static std::map<std::string, Result> LoadBaseline(const std::string& file) {
+  std::ifstream fin(file);
+  if (!fin)
+    throw std::runtime_error("Regression error: File [" + file +
+                             "] does not exist.");
+  std::map<std::string, Result> baseline;
+  std::string line;
+  std::getline(fin, line);
+  while (std::getline(fin, line)) {
+    std::replace(line.begin(), line.end(), ',', ' ');
+    std::istringstream stream(line);
+    std::string name;
+    Result result;
+    if (stream >> name >> result.cycles_per_second >> result.peak_rss_kb >>
+        result.startup_seconds)
+      baseline[name] = result;
+  }
+  return baseline;
+}
+
+// Simulator reports "<cycles> cycles executed in <seconds>s", the rest of
+// the wall time is spent on startup and reporting
+static bool Run(const std::string& simulator, const Case& c, Result& result) {
+  std::vector<char*> argv;
+  argv.push_back(const_cast<char*>(simulator.c_str()));
+  for (const std::string& arg : c.args)
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  argv.push_back(const_cast<char*>("-report_progress"));
+  argv.push_back(const_cast<char*>("false"));
+  argv.push_back(nullptr);
+
+  int fd[2];
+  if (pipe(fd)) return false;
+  auto start = std::chrono::steady_clock::now();
+  pid_t pid = fork();
+  if (pid < 0) return false;
+  if (!pid) {
+    dup2(fd[1], STDOUT_FILENO);
+    dup2(fd[1], STDERR_FILENO);
+    close(fd[0]);
+    close(fd[1]);
+    execv(simulator.c_str(), argv.data());
+    _exit(127);
+  }
+  close(fd[1]);
+  std::string output;
+  char buffer[4096];
+  for (ssize_t n; (n = read(fd[0], buffer, sizeof(buffer))) > 0;)
+    output.append(buffer, n);
+  close(fd[0]);
+
+  int status;
+  rusage usage;
+  wait4(pid, &status, 0, &usage);
+  double wall = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+  if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+    std::cerr << output;
+    return false;
+  }
+
+  std::size_t pos = output.find(" cycles executed in ");
+  if (pos == std::string::npos) return false;
+  std::size_t begin = output.find_last_of('\n', pos) + 1;
+  double cycles = std::atof(output.c_str() + begin);
+  double seconds =
+      std::atof(output.c_str() + pos + std::strlen(" cycles executed in "));
+  result.cycles_per_second = cycles / seconds;
+  result.peak_rss_kb = usage.ru_maxrss;
+  result.startup_seconds = wall - seconds;
+  return true;
+}
+
+static std::string Compare(const Result& result, const Result& base,
+                           double threshold) {
+  std::string regressed;
+  auto flag = [&](bool worse, const std::string& metric) {
+    if (worse) regressed += (regressed.empty() ? "" : ";") + metric;
+  };
+  flag(result.cycles_per_second < base.cycles_per_second * (1 - threshold),
+       "cycles_per_second");
+  flag(result.peak_rss_kb > base.peak_rss_kb * (1 + threshold), "peak_rss_kb");
+  flag(result.startup_seconds >
+           base.startup_seconds * (1 + threshold) + StartupSlack,
+       "startup_seconds");
+  return regressed.empty() ? "OK" : "REGRESSION:" + regressed;
+}
+
+int main(int argc, char* argv[]) {
+  std::string simulator = "./newxim";
+  std::string cases_file = "benchmarks/cases.txt";
+  std::string baseline_file, save_file, filter;
+  double threshold = 10;
+  std::int32_t repeat = 1;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string option = argv[i];
+    if (option == "-simulator")
+      simulator = argv[i + 1];
+    else if (option == "-cases")
+      cases_file = argv[i + 1];
+    else if (option == "-baseline")
+      baseline_file = argv[i + 1];
+    else if (option == "-save")
+      save_file = argv[i + 1];
+    else if (option == "-threshold")
+      threshold = std::atof(argv[i + 1]);
+    else if (option == "-repeat")
+      repeat = std::max(1, std::atoi(argv[i + 1]));
+    else if (option == "-filter")
+      filter = argv[i + 1];
+    else {
+      std::cerr << "Error: Invalid option [" << option << "].\n";
+      return 1;
+    }
+  }
+
+  try {
+    std::vector<Case> cases = LoadCases(cases_file);
+    std::map<std::string, Result> baseline;
+    if (!baseline_file.empty()) baseline = LoadBaseline(baseline_file);
+    std::ofstream save;
+    if (!save_file.empty()) {
+      save.open(save_file);
+      save << "name,cycles_per_second,peak_rss_kb,startup_seconds\n";
+    }
+
+    bool failed = false;
+    std::cout << "name,cycles_per_second,peak_rss_kb,startup_seconds,status\n";
+    for (const Case& c : cases) {
+      if (c.name.find(filter) == std::string::npos) continue;
+      std::cerr << "Running " << c.name << "...\n";
+
+      // Best of repeated runs is taken to reduce noise of the machine
+      Result best;
+      bool ok = true;
+      for (std::int32_t r = 0; r < repeat && ok; r++) {
+        Result result;
+        ok = Run(simulator, c, result);
+        if (!r || result.cycles_per_second > best.cycles_per_second)
+          best.cycles_per_second = result.cycles_per_second;
+        if (!r || result.peak_rss_kb < best.peak_rss_kb)
+          best.peak_rss_kb = result.peak_rss_kb;
+        if (!r || result.startup_seconds < best.startup_seconds)
+          best.startup_seconds = result.startup_seconds;
+      }
+
+      std::string status = "FAILED";
+      if (ok) {
+        auto base = baseline.find(c.name);
+        status = base == baseline.end()
+                     ? "NEW"
+                     : Compare(best, base->second, threshold / 100);
+        if (save)
+          save << c.name << ',' << best.cycles_per_second << ','
+               << best.peak_rss_kb << ',' << best.startup_seconds << '\n';
+      }
+      failed |= status != "OK" && status != "NEW";
+      std::cout << c.name << ',' << best.cycles_per_second << ','
+                << best.peak_rss_kb << ',' << best.startup_seconds << ','
+                << status << std::endl;
+    }
+    return failed;
+  } catch (const std::exception& ex) {
+    std::cerr << "Error: " << ex.what() << '\n';
+    return 1;
+  }
+}
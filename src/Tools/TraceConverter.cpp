@@ -0,0 +1,91 @@
+// Offline converter of binary flit trace written by streaming FlitTracer.
+// Usage: newxim_trace <trace file> [text|chrome]
+// Text format lists events in order of simulation, Chrome format groups
+// events by flit and shows time spent at each router as trace slices,
+// which can be opened by chrome://tracing or Perfetto.
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Metrics/FlitEvent.hpp"
+
+static std::vector<FlitEvent> Load(const std::string& file) {
+  std::ifstream fin(file, std::ios::in | std::ios::binary);
+  char header[8];
+  if (!fin || !fin.read(header, sizeof(header)) ||
+      std::memcmp(header, "NXFLITS", 8) != 0)
+    throw std::runtime_error("File [" + file + "] is not a flit trace.");
+
+  std::vector<FlitEvent> events;
+  FlitEvent event;
+  while (fin.read(reinterpret_cast<char*>(&event), sizeof(event)))
+    events.push_back(event);
+  if (fin.gcount() != 0)
+    throw std::runtime_error("File [" + file + "] is truncated.");
+  return events;
+}
+
+static std::string FlitTypeName(std::uint8_t flags) {
+  std::string name;
+  if (flags & 0b001) name += 'H';
+  if (flags & 0b010) name += 'B';
+  if (flags & 0b100) name += 'T';
+  return name;
+}
+
+static void WriteText(const std::vector<FlitEvent>& events, std::ostream& os) {
+  static const char* kinds[] = {"inject", "hop", "eject"};
+  os << "% cycle id type src dst event node port vc\n";
+  for (const FlitEvent& e : events) {
+    os << e.cycle << ' ' << e.id << ' ' << FlitTypeName(e.flags) << ' '
+       << e.src << ' ' << e.dst << ' ' << kinds[e.GetKind()] << ' ' << e.node
+       << ' ' << e.port << ' ' << static_cast<std::int32_t>(e.vc) << '\n';
+  }
+}
+
+static void WriteChrome(std::vector<FlitEvent> events, std::ostream& os) {
+  // Slice of each event lasts until the next event of the same flit,
+  // process is node and thread is input port (0 for processor)
+  std::stable_sort(
+      events.begin(), events.end(),
+      [](const FlitEvent& l, const FlitEvent& r) { return l.id < r.id; });
+  os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  for (std::size_t i = 0; i + 1 < events.size(); i++) {
+    const FlitEvent& e = events[i];
+    const FlitEvent& next = events[i + 1];
+    if (next.id != e.id) continue;
+    os << (first ? "" : ",") << "\n{\"name\":\"" << FlitTypeName(e.flags)
+       << ' ' << e.src << "->" << e.dst << "\",\"cat\":\"flit\",\"ph\":\"X\""
+       << ",\"ts\":" << e.cycle << ",\"dur\":" << next.cycle - e.cycle
+       << ",\"pid\":" << e.node << ",\"tid\":" << e.port + 1
+       << ",\"args\":{\"id\":" << e.id
+       << ",\"vc\":" << static_cast<std::int32_t>(e.vc) << "}}";
+    first = false;
+  }
+  os << "\n]}\n";
+}
+
+int main(int argc, char* argv[]) {
+  try {
+    std::string format = argc > 2 ? argv[2] : "text";
+    if (argc < 2 || argc > 3 || (format != "text" && format != "chrome")) {
+      std::cerr << "Usage: " << argv[0] << " <trace file> [text|chrome]\n";
+      return 1;
+    }
+
+    auto events = Load(argv[1]);
+    if (format == "text")
+      WriteText(events, std::cout);
+    else
+      WriteChrome(std::move(events), std::cout);
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "Error: " << ex.what() << '\n';
+    return 1;
+  }
+}